@@ -71,6 +71,12 @@ char * shared_function_names [NUMBER_OF_SHARED_FUNCTIONS] = {
     "ENTER_STANDBY",
 };
 
+char * shared_function_ext_names [NUMBER_OF_SHARED_FUNCTIONS_EXT] = {
+    "SHA256_UPDATE",
+    "RSA2048_VERIFY_MONT",
+    "RSA_VERIFY_N",
+};
+
 
 
 /**
@@ -355,6 +361,12 @@ void report_communication_area(void) {
         dbgprintx("  ", shared_function_names[i], NULL);
         dbgprintxptr("  0x", comm_area->shared_functions[i], "\n");
     }
+    for (i = 0; i < NUMBER_OF_SHARED_FUNCTIONS_EXT; i++) {
+        dbgprintx("  ", shared_function_ext_names[i], NULL);
+        dbgprintxptr("  0x",
+                     get_shared_function_ext((shared_function_ext_index)i),
+                     "\n");
+    }
     dbgprint("\n");
 
     /* endpoint_unique_id */
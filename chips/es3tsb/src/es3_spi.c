@@ -40,7 +40,10 @@ static uint32_t current_addr;
 #define SPIM_SSIENR (SPI_BASE + 0x08)
 #define SPIM_SER    (SPI_BASE + 0x10)
 #define SPIM_BAUDR  (SPI_BASE + 0x14)
+#define SPIM_RXFTLR (SPI_BASE + 0x1C)
+#define SPIM_RXFLR  (SPI_BASE + 0x24)
 #define SPIM_SR     (SPI_BASE + 0x28)
+#define SPIM_RISR   (SPI_BASE + 0x34)
 #define SPIM_DR0    (SPI_BASE + 0x60)
 
 /* CTRLR0 value: 32bit frame, EEPROM read mode */
@@ -49,6 +52,8 @@ static uint32_t current_addr;
 #define SPIM_SR_RFNE 0x08
 #define SPIM_SR_BUSY 0x01
 
+#define SPIM_RISR_RXOIR 0x08
+
 /* SCKDV: 2 - 24MHz SPI CLK */
 #define SPIM_SCKDV 2
 
@@ -59,8 +64,43 @@ static uint32_t current_addr;
 
 #define SPI_FLASH_READ_CMD 0x03
 
+/* Largest RX FIFO threshold the controller can be built with */
+#define SPIM_RX_FIFO_MAX 256
+
 int spi_clk_usage_count = 0;
 
+/* RX FIFO depth in 32bit frames, found at init */
+static uint32_t spi_rx_fifo_frames;
+/*
+ * Hashing runs between FIFO drains of a single read, so a hash chunk has to
+ * take less time than the FIFO takes to fill. Cleared for good the first
+ * time that is not so.
+ */
+static bool spi_overlap = true;
+
+#ifdef _SPI_STATS
+/*
+ * Polls that found too little in the RX FIFO to drain, hash chunks run while
+ * frames were arriving, READ commands issued, FIFO overruns and Cortex-M3
+ * cycles spent in hashed loads. Comparing the first two shows how much of
+ * the hash hides under the SPI transfer.
+ */
+uint32_t spi_idle_polls = 0;
+uint32_t spi_hashed_chunks = 0;
+uint32_t spi_read_cmds = 0;
+uint32_t spi_overruns = 0;
+uint32_t spi_load_cycles = 0;
+#define SPI_STAT(x) (x)++
+
+#define DEMCR       0xE000EDFC
+#define DEMCR_TRCENA (1 << 24)
+#define DWT_CTRL    0xE0001000
+#define DWT_CYCCNT  0xE0001004
+#define SPI_CYCLES() getreg32(DWT_CYCCNT)
+#else
+#define SPI_STAT(x)
+#endif
+
 static int data_load_spi_init(void) {
     current_addr = 0;
 
@@ -75,16 +115,126 @@ static int data_load_spi_init(void) {
     putreg32(SPIM_SCKDV,  SPIM_BAUDR);
     putreg32(SPIM_SLAVE_SELECT,  SPIM_SER);
 
+    /* RXFTLR only keeps the bits a threshold below the FIFO depth needs */
+    for (spi_rx_fifo_frames = 1; spi_rx_fifo_frames < SPIM_RX_FIFO_MAX;
+         spi_rx_fifo_frames++) {
+        putreg32(spi_rx_fifo_frames, SPIM_RXFTLR);
+        if (getreg32(SPIM_RXFTLR) != spi_rx_fifo_frames) {
+            break;
+        }
+    }
+    putreg32(0, SPIM_RXFTLR);
+
+#ifdef _SPI_STATS
+    putreg32(getreg32(DEMCR) | DEMCR_TRCENA, DEMCR);
+    putreg32(getreg32(DWT_CTRL) | 1, DWT_CTRL);
+#endif
     return 0;
 }
 
+/* Start reading count 32bit frames from addr */
+static void spi_start(uint32_t addr, uint32_t count) {
+    SPI_STAT(spi_read_cmds);
+    putreg32(count - 1, SPIM_CTRLR1);
+    putreg32(SPIM_SSI_ENABLE,  SPIM_SSIENR);
+    putreg32((SPI_FLASH_READ_CMD << 24) | addr, SPIM_DR0);
+}
+
+/* Drain the frames of the read in progress into pdest, returns the count */
+static uint32_t spi_drain(unsigned char *pdest) {
+    uint32_t c = 0;
+    uint32_t sr, dr;
+    unsigned char *pdr = (unsigned char *)&dr;
+
+    while(1) {
+        sr = getreg32(SPIM_SR);
+        /* The spec says that "BUSY" doesn't happen right away with not much
+           explaination. However, it should be safe to assume it would happen
+           no later than the first frame is received */
+        if (c && !(sr & (SPIM_SR_BUSY | SPIM_SR_RFNE))) {
+            break;
+        }
+        if (sr & SPIM_SR_RFNE) {
+            dr = getreg32(SPIM_DR0);
+            *pdest++ = pdr[3];
+            *pdest++ = pdr[2];
+            *pdest++ = pdr[1];
+            *pdest++ = pdr[0];
+            c++;
+        } else {
+            SPI_STAT(spi_idle_polls);
+        }
+    }
+    putreg32(SPIM_SSI_DISABLE,  SPIM_SSIENR);
+    return c;
+}
+
+/* Move n frames that are already in the RX FIFO to pdest */
+static void spi_read_frames(unsigned char *pdest, uint32_t n) {
+    uint32_t dr;
+    unsigned char *pdr = (unsigned char *)&dr;
+
+    while (n--) {
+        dr = getreg32(SPIM_DR0);
+        *pdest++ = pdr[3];
+        *pdest++ = pdr[2];
+        *pdest++ = pdr[1];
+        *pdest++ = pdr[0];
+    }
+}
+
+/*
+ * Read count frames in one READ transaction, hashing as it goes. Whenever
+ * a hash_chunk_size() chunk is complete, empty the FIFO and hash the chunk
+ * while the FIFO refills; otherwise let the FIFO fill to half its depth and
+ * drain it in one go, rather than polling for every frame. Returns the
+ * number of frames read, which is short of count if the FIFO overran
+ * during a chunk; *hashed is advanced past the data given to hash_update.
+ */
+static uint32_t spi_load_hashed(unsigned char *pdest, uint32_t count,
+                                unsigned char **hashed) {
+    uint32_t c = 0;
+    uint32_t n;
+    uint32_t chunk = hash_chunk_size();
+    uint32_t threshold = spi_rx_fifo_frames / 2;
+
+    spi_start(current_addr, count);
+    while (c < count) {
+        n = getreg32(SPIM_RXFLR);
+        /* the FIFO can only have overrun if it is full */
+        if (n >= spi_rx_fifo_frames &&
+            (getreg32(SPIM_RISR) & SPIM_RISR_RXOIR)) {
+            break;
+        }
+
+        if (pdest + ((c + n) << 2) - *hashed >= chunk) {
+            spi_read_frames(pdest + (c << 2), n);
+            c += n;
+            hash_update(*hashed, chunk);
+            *hashed += chunk;
+            SPI_STAT(spi_hashed_chunks);
+        } else if (n > threshold || (n && c + n == count)) {
+            spi_read_frames(pdest + (c << 2), n);
+            c += n;
+        } else {
+            SPI_STAT(spi_idle_polls);
+        }
+    }
+    putreg32(SPIM_SSI_DISABLE,  SPIM_SSIENR);
+    return c;
+}
+
 /* TA-15 CM3 perform read data transfer from SPI memory to data transfer... */
 static int data_load_spi_load(void *dest, uint32_t length, bool hash) {
     uint32_t c;
     uint32_t sr, dr;
     unsigned char *pdest = (unsigned char *)dest;
     unsigned char *pdr = (unsigned char *)&dr;
+    unsigned char *hashed = pdest;
     uint32_t count = length >> 2;
+#ifdef _SPI_STATS
+    uint32_t start_cycles = SPI_CYCLES();
+#endif
 
     if (length == 0) {
         return 0;
@@ -105,28 +255,25 @@ static int data_load_spi_load(void *dest, uint32_t length, bool hash) {
         return -1;
     }
 
-    putreg32(count - 1, SPIM_CTRLR1);
-    putreg32(SPIM_SSI_ENABLE,  SPIM_SSIENR);
-    putreg32((SPI_FLASH_READ_CMD << 24) | current_addr, SPIM_DR0);
-    c = 0;
-    while(1) {
-        sr = getreg32(SPIM_SR);
-        /* The spec says that "BUSY" doesn't happen right away with not much
-           explaination. However, it should be safe to assume it would happen
-           no later than the first frame is received */
-        if (c && !(sr & (SPIM_SR_BUSY | SPIM_SR_RFNE))) {
-            break;
-        }
-        if (sr & SPIM_SR_RFNE) {
-            dr = getreg32(SPIM_DR0);
-            *pdest++ = pdr[3];
-            *pdest++ = pdr[2];
-            *pdest++ = pdr[1];
-            *pdest++ = pdr[0];
-            c++;
+    if (count > 0) {
+        if (hash && spi_overlap) {
+            c = spi_load_hashed(pdest, count, &hashed);
+            if (c != count) {
+                /* A chunk took longer than the FIFO: finish the read as
+                   one tight drain, and hash after it from now on */
+                SPI_STAT(spi_overruns);
+                spi_overlap = false;
+                spi_start((current_addr + (c << 2)) & 0x00FFFFFF, count - c);
+                c += spi_drain(pdest + (c << 2));
+            }
+        } else {
+            spi_start(current_addr, count);
+            c = spi_drain(pdest);
         }
+        pdest += c << 2;
+    } else {
+        c = 0;
     }
-    putreg32(SPIM_SSI_DISABLE,  SPIM_SSIENR);
 
     if (c != count) {
         /* During experiment, RX FIFO overflow was observed in certain
@@ -144,9 +291,7 @@ static int data_load_spi_load(void *dest, uint32_t length, bool hash) {
 
     if (0 != count) {
         /* read trailing bytes */
-        putreg32(0, SPIM_CTRLR1);
-        putreg32(SPIM_SSI_ENABLE,  SPIM_SSIENR);
-        putreg32((SPI_FLASH_READ_CMD << 24) | current_addr, SPIM_DR0);
+        spi_start(current_addr, 1);
         while(1) {
             sr = getreg32(SPIM_SR);
             if (sr & SPIM_SR_RFNE) {
@@ -162,7 +307,11 @@ static int data_load_spi_load(void *dest, uint32_t length, bool hash) {
     }
 
     if (hash) {
-        hash_update((unsigned char *)dest, length);
+        /* whatever was not already hashed during the read */
+        hash_update(hashed, pdest - hashed);
+#ifdef _SPI_STATS
+        spi_load_cycles += SPI_CYCLES() - start_cycles;
+#endif
     }
     return 0;
 }
@@ -176,7 +325,20 @@ static int data_load_spi_read(void *dest, uint32_t addr, uint32_t length) {
     return data_load_spi_load(dest, length, false);
 }
 
+static int data_load_spi_skip(uint32_t length) {
+    current_addr = (current_addr + length) & 0x00FFFFFF;
+    return 0;
+}
+
 static int data_load_spi_finish(bool valid, bool is_secure_image) {
+#ifdef _SPI_STATS
+    dbgprintx32("SPI RX FIFO frames: ", spi_rx_fifo_frames, "\r\n");
+    dbgprintx32("SPI idle polls: ", spi_idle_polls, "\r\n");
+    dbgprintx32("SPI hashed chunks: ", spi_hashed_chunks, "\r\n");
+    dbgprintx32("SPI READ commands: ", spi_read_cmds, "\r\n");
+    dbgprintx32("SPI overruns: ", spi_overruns, "\r\n");
+    dbgprintx32("SPI hashed load cycles: ", spi_load_cycles, "\r\n");
+#endif
     spi_clk_usage_count--;
     if (spi_clk_usage_count == 0) {
         tsb_clk_disable(TSB_CLK_SPIP);
@@ -189,5 +351,6 @@ data_load_ops spi_ops = {
     .init = data_load_spi_init,
     .read = data_load_spi_read,
     .load = data_load_spi_load,
+    .skip = data_load_spi_skip,
     .finish = data_load_spi_finish
 };
@@ -277,6 +277,14 @@ bool chip_is_untrusted_image_allowed(void) {
     return true;
 }
 
+const struct hash_backend *chip_hash_backend(void) {
+    /*
+     * No driver for the crypto block yet, so always hash in software. A
+     * driver would also honour TSB_ISAA_DISABLE_HARDWARE_CRYPTO in the SCR.
+     */
+    return NULL;
+}
+
 uint32_t tsb_get_scr(void) {
     return isaa_read(TSB_ISAA_SCR);
 }
@@ -228,4 +228,12 @@ void chip_clear_image_loading_ram(void);
  */
 bool chip_is_untrusted_image_allowed(void);
 
+/**
+ * @brief get the chip's hardware SHA-256 engine, if it has one
+ * @return the backend for the engine, or NULL to hash in software (no
+ *         engine, or hardware crypto disabled for this part)
+ */
+struct hash_backend;
+const struct hash_backend *chip_hash_backend(void);
+
 #endif /* __COMMON_INCLUDE_CHIPAPI_H */
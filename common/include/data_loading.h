@@ -58,12 +58,28 @@ typedef int (*data_loading_init)(void);
 typedef int (*data_loading_read)(void *dest, uint32_t addr, uint32_t length);
 typedef int (*data_loading_load)(void *dest, uint32_t length, bool hash);
 
+/**
+ * "rewind" steps the "load" position back by length bytes, so that data that
+ * failed a check can be loaded again. Set it to NULL for methods where a
+ * second attempt would only return the same data.
+ */
+typedef int (*data_loading_rewind)(uint32_t length);
+
+/**
+ * "skip" steps the "load" position forward by length bytes without
+ * transferring the data, for data that is not hashed and not needed. Set it
+ * to NULL if the data can only be reached by loading it.
+ */
+typedef int (*data_loading_skip)(uint32_t length);
+
 typedef int (*data_loading_finish)(bool valid, bool is_secure_image);
 
 typedef struct {
     data_loading_init init;
     data_loading_read read;
     data_loading_load load;
+    data_loading_rewind rewind;
+    data_loading_skip skip;
     data_loading_finish finish;
 } data_load_ops;
 
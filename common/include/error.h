@@ -75,6 +75,8 @@
 #define BRE_TFTF_IMAGE_CORRUPTED    ((uint32_t)(BRE_TFTF_BASE + 14))
 #define BRE_TFTF_LOAD_DATA          ((uint32_t)(BRE_TFTF_BASE + 15))
 #define BRE_TFTF_UNTRUSTED_NOT_ALLOWED    ((uint32_t)(BRE_TFTF_BASE + 16))
+#define BRE_TFTF_CHUNK_TABLE        ((uint32_t)(BRE_TFTF_BASE + 17))
+#define BRE_TFTF_CHUNK_DIGEST       ((uint32_t)(BRE_TFTF_BASE + 18))
 
 #define BRE_FFFF_BASE               ((uint32_t)0x000040)
 #define BRE_FFFF_LOAD_HEADER        ((uint32_t)(BRE_FFFF_BASE + 0))
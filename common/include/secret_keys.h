@@ -44,6 +44,65 @@ void calculate_epuid(uint8_t *ims, union large_uint * endpoint_id);
 
 void key_generation(uint8_t *ims);
 
+/**
+ * @brief Get EPVK, the C448 public key of EPSK
+ *
+ * The point is computed on the first call, in whichever stage makes it, and
+ * cached in the communication area. Later calls, in that stage or a later
+ * one, get it from there.
+ *
+ * @param pk Buffer for the uncompressed point, 0x04 || x || y
+ * @param pk_size Size of pk, at least EPVK_SIZE
+ *
+ * @returns 0 on success, -EINVAL on bad buffers, -ENOENT if the keys
+ *          have not been generated
+ */
+int get_epvk(uint8_t *pk, size_t pk_size);
+
+/**
+ * @brief Get ESVK, the C25519 public key of ESSK
+ *
+ * As get_epvk().
+ *
+ * @param pk Buffer for the uncompressed point, 0x04 || x || y
+ * @param pk_size Size of pk, at least ESVK_SIZE
+ *
+ * @returns 0 on success, -EINVAL on bad buffers, -ENOENT if the keys
+ *          have not been generated
+ */
+int get_esvk(uint8_t *pk, size_t pk_size);
+
+/**
+ * @brief Sign a message with ERRK, RSASSA-PKCS1-v1_5 with SHA-256
+ *
+ * @param message The message to sign
+ * @param len Length of message
+ * @param sig Buffer for the big endian signature
+ * @param sig_size Size of sig, at least ERRK_N_SIZE
+ *
+ * @returns 0 on success, -EINVAL on bad buffers, -ENOENT if the keys
+ *          have not been generated
+ */
+int sign_message_with_errk(uint8_t *message, size_t len,
+                           uint8_t *sig, size_t sig_size);
+
+/**
+ * @brief Raw RSA decryption with ERRK, plaintext = ciphertext^ERRK_D
+ *
+ * Any padding (OAEP, PKCS #1 v1.5) is left to the caller.
+ *
+ * @param ciphertext Big endian ciphertext, less than ERRK_N
+ * @param len Length of ciphertext, must be ERRK_N_SIZE
+ * @param plaintext Buffer for the big endian result
+ * @param plaintext_size Size of plaintext, at least ERRK_N_SIZE
+ *
+ * @returns 0 on success, -EINVAL on bad buffers, -ERANGE if the ciphertext
+ *          is not less than ERRK_N, -ENOENT if the keys have not been
+ *          generated
+ */
+int decrypt_with_errk(uint8_t *ciphertext, size_t len,
+                      uint8_t *plaintext, size_t plaintext_size);
+
 /**
  * @brief A commonly used function in key generation
  * output = sha256(input || copy(val_to_concat, num_to_concat))
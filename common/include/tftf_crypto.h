@@ -43,5 +43,6 @@ typedef char ___key_name_test[(sizeof (___test_signature.key_name) ==
                                sizeof (___test_key.key_name)) ?
                               1 : -1];
 
+int check_signature_key(tftf_signature *signature);
 int verify_signature(unsigned char *digest, tftf_signature *signature);
 #endif /* __COMMON_INCLUDE_TFTF_CRYPTO_H */
@@ -32,8 +32,6 @@
 #include <stdint.h>
 #include <crypto.h>
 
-#define S2LCFG_MAX_SIZE 1024
-
 #define SECONDSTAGE_CFG_SENTINEL_SIZE 16
 /**
  * config data sentinel value. It is a 16bytes char array. The trailing '\0'
@@ -63,8 +61,43 @@ typedef struct {
 
     uint32_t number_of_public_keys;
     crypto_public_key public_keys[0];
+    /*
+     * optionally followed by a crypto_key_ext, then a crypto_key_index,
+     * then a crypto_key_large
+     */
 } __attribute__ ((packed)) secondstage_cfgdata;
 
+/*
+ * .s2lcfg is part of the second stage image, so it is loaded and hashed on
+ * every boot: size it for the keys it has to carry, not more.
+ * S2LCFG_KEY_INDEX_SLOTS is the smallest power of two of at least twice
+ * S2LCFG_NUMBER_OF_KEYS, as tools/pem2keytable sizes the index. Room for the
+ * RSA3072/RSA4096 trailer, 612 bytes a key, is only made in builds that set
+ * S2LCFG_NUMBER_OF_LARGE_KEYS.
+ */
+#define S2LCFG_NUMBER_OF_KEYS       2
+#define S2LCFG_KEY_INDEX_SLOTS      4
+#ifndef S2LCFG_NUMBER_OF_LARGE_KEYS
+#define S2LCFG_NUMBER_OF_LARGE_KEYS 0
+#endif
+
+#if S2LCFG_NUMBER_OF_LARGE_KEYS > 0
+#define S2LCFG_LARGE_SIZE \
+    (sizeof(crypto_key_large) + \
+     S2LCFG_NUMBER_OF_LARGE_KEYS * sizeof(crypto_public_key_large))
+#else
+#define S2LCFG_LARGE_SIZE 0
+#endif
+
+#define S2LCFG_MAX_SIZE \
+    (sizeof(secondstage_cfgdata) + \
+     S2LCFG_NUMBER_OF_KEYS * sizeof(crypto_public_key) + \
+     sizeof(crypto_key_ext) + \
+     S2LCFG_NUMBER_OF_KEYS * sizeof(crypto_key_mont) + \
+     sizeof(crypto_key_index) + \
+     S2LCFG_KEY_INDEX_SLOTS * sizeof(crypto_key_slot) + \
+     S2LCFG_LARGE_SIZE)
+
 /**
  * @brief get pointer for second stage config data
  * @param cfgdata pointer to the config data
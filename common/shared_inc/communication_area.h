@@ -29,6 +29,7 @@
 #ifndef __COMMON_INCLUDE_COMMUNICATION_AREA_H
 #define __COMMON_INCLUDE_COMMUNICATION_AREA_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*
@@ -64,11 +65,58 @@ typedef enum {
     NUMBER_OF_SHARED_FUNCTIONS
 } shared_function_index;
 
+/*
+ * shared_functions[] ends at a fixed address, so ROMs that have shipped pin
+ * its length. Entry points added since then live in a table of their own,
+ * placed directly below shared_functions[]. Only fixed-size fields sit above
+ * it, so its top is at SHARED_FUNCTIONS_EXT_TOP whatever happens to the
+ * variable-sized areas below it. A ROM that fills it in sets magic and count,
+ * so later stages can tell whether (and how much of) the table is there and
+ * fall back to the older entry points when it is not. New entries go at the
+ * end of the enum; they are stored from the top of functions[] down, so every
+ * entry keeps its address as the table grows.
+ */
+#define SHARED_FUNCTIONS_EXT_MAGIC  0x46584553 /* "SEXF" */
+
+typedef enum {
+    SHARED_FUNCTION_EXT_SHA256_UPDATE,
+    SHARED_FUNCTION_EXT_RSA2048_VERIFY_MONT,
+    SHARED_FUNCTION_EXT_RSA_VERIFY_N,
+    NUMBER_OF_SHARED_FUNCTIONS_EXT
+} shared_function_ext_index;
+
+typedef struct {
+    void * functions[NUMBER_OF_SHARED_FUNCTIONS_EXT];
+    uint32_t count;
+    uint32_t magic;
+} __attribute__ ((packed)) shared_functions_ext_area;
+
 #define EPSK_SIZE           56
 #define ESSK_SIZE           32
 #define ERGS_SIZE           32
 #define ERRK_N_SIZE         256
+/* Uncompressed public points, 0x04 || x || y */
+#define EPVK_SIZE           (2 * EPSK_SIZE + 1)
+#define ESVK_SIZE           (2 * ESSK_SIZE + 1)
+
+/* secret_keys_comm_area.keys_valid flags */
+#define EPVK_VALID          0x00000001
+#define ESVK_VALID          0x00000002
+#define SECRET_KEYS_VALID   0x00000004
+
+/*
+ * Second stage FW sets SECRET_KEYS_VALID in keys_valid once it has derived
+ * the secret keys, so any stage linking secret_keys.c can tell they are
+ * there. epvk and esvk are the public keys of epsk and essk. Whichever stage
+ * first asks for one works it out and sets the matching keys_valid flag, and
+ * every later request, in that stage or a later one, takes it from here
+ * instead of doing a scalar multiplication. Like the communication area
+ * itself, new fields go BEFORE the existing ones.
+ */
 typedef struct {
+    uint32_t keys_valid;
+    uint8_t epvk[EPVK_SIZE];
+    uint8_t esvk[ESVK_SIZE];
     uint8_t epsk[EPSK_SIZE];
     uint8_t essk[ESSK_SIZE];
     uint8_t ergs[ERGS_SIZE];
@@ -81,6 +129,7 @@ typedef struct {
 
 #define COMMUNICATION_AREA_DATA_FIELDS \
     second_stage_comm_area second_stage; \
+    shared_functions_ext_area shared_functions_ext; \
     void * shared_functions[NUMBER_OF_SHARED_FUNCTIONS]; \
     unsigned char endpoint_unique_id[EUID_LENGTH]; \
     unsigned char stage_2_firmware_identity[S2_FW_ID_LENGTH]; \
@@ -101,6 +150,21 @@ typedef struct {
     COMMUNICATION_AREA_DATA_FIELDS;
 } __attribute__ ((packed)) communication_area;
 
+/*
+ * Offset of the top of shared_functions_ext from the start of the area:
+ * everything above it (shared_functions[], the identity strings and
+ * resume_data) is fixed by the ROMs that have shipped.
+ */
+#define SHARED_FUNCTIONS_EXT_TOP \
+    (COMMUNICATION_AREA_LENGTH - \
+     NUMBER_OF_SHARED_FUNCTIONS * sizeof(void *) - \
+     EUID_LENGTH - S2_FW_ID_LENGTH - S2_KEY_NAMELENGTH - 16 - 48 - \
+     sizeof(resume_communication_area))
+
+typedef char ___shared_functions_ext_test[
+    (offsetof(communication_area, shared_functions_ext) +
+     sizeof(shared_functions_ext_area) == SHARED_FUNCTIONS_EXT_TOP) ? 1 : -1];
+
 extern unsigned char _communication_area;
 
 static inline void *get_shared_function(shared_function_index index) {
@@ -124,4 +188,51 @@ static inline void set_shared_function(shared_function_index index,
     p->shared_functions[index] = func;
 }
 
+/**
+ * @brief Mark the extended shared function table as provided, all empty
+ *
+ * Only the boot ROM calls this, before setting any of the entries.
+ */
+static inline void init_shared_functions_ext(void) {
+    communication_area *p = (communication_area *)&_communication_area;
+    int i;
+
+    for (i = 0; i < NUMBER_OF_SHARED_FUNCTIONS_EXT; i++) {
+        p->shared_functions_ext.functions[i] = NULL;
+    }
+    p->shared_functions_ext.count = NUMBER_OF_SHARED_FUNCTIONS_EXT;
+    p->shared_functions_ext.magic = SHARED_FUNCTIONS_EXT_MAGIC;
+}
+
+/**
+ * @brief Get an entry of the extended shared function table
+ *
+ * @returns The function, or NULL if the ROM that booted us does not
+ *          provide it
+ */
+static inline void *get_shared_function_ext(shared_function_ext_index index) {
+    communication_area *p = (communication_area *)&_communication_area;
+
+    if (index >= NUMBER_OF_SHARED_FUNCTIONS_EXT ||
+        p->shared_functions_ext.magic != SHARED_FUNCTIONS_EXT_MAGIC ||
+        index >= p->shared_functions_ext.count) {
+        return NULL;
+    }
+
+    return p->shared_functions_ext.functions[NUMBER_OF_SHARED_FUNCTIONS_EXT -
+                                             1 - index];
+}
+
+static inline void set_shared_function_ext(shared_function_ext_index index,
+                                           void *func) {
+    if (index >= NUMBER_OF_SHARED_FUNCTIONS_EXT) {
+        dbgprint("shared-fn-ext index too big\n");
+        return;
+    }
+
+    communication_area *p = (communication_area *)&_communication_area;
+    p->shared_functions_ext.functions[NUMBER_OF_SHARED_FUNCTIONS_EXT - 1 -
+                                      index] = func;
+}
+
 #endif /* __COMMON_INCLUDE__COMMUNICATION_AREA_H */
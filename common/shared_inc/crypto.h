@@ -33,8 +33,13 @@
 
 #define SHA256_HASH_DIGEST_SIZE 32
 #define RSA2048_PUBLIC_KEY_SIZE 256
+#define RSA3072_PUBLIC_KEY_SIZE 384
+#define RSA4096_PUBLIC_KEY_SIZE 512
+#define RSA_MAX_PUBLIC_KEY_SIZE RSA4096_PUBLIC_KEY_SIZE
 
 #define ALGORITHM_TYPE_RSA2048_SHA256 0x01
+#define ALGORITHM_TYPE_RSA3072_SHA256 0x02
+#define ALGORITHM_TYPE_RSA4096_SHA256 0x03
 
 typedef struct {
     uint32_t type;
@@ -42,13 +47,122 @@ typedef struct {
     unsigned char key[RSA2048_PUBLIC_KEY_SIZE];
 } __attribute__ ((packed)) crypto_public_key;
 
+/**
+ * @brief Montgomery constants of one public key, precomputed at build time
+ *
+ * n0inv is -1/n mod 2^32 and r2 is R^2 mod n (R = 2^2048), big-endian like
+ * the key itself. tools/pem2keytable generates them from the key files.
+ */
+typedef struct {
+    uint32_t n0inv;
+    unsigned char r2[RSA2048_PUBLIC_KEY_SIZE];
+} __attribute__ ((packed)) crypto_key_mont;
+
+#define CRYPTO_KEY_EXT_SENTINEL 0x7478656b /* "kext" */
+#define CRYPTO_KEY_EXT_VERSION  1
+
+/**
+ * @brief Optional extension to a public key table
+ *
+ * Holds one entry per key, in key table order. It follows public_keys[]
+ * in the second stage config data, and is public_keys_ext for the boot ROM
+ * table. Tables without one (or with another version, or a different key
+ * count) still work: the verifier then derives the constants at boot.
+ */
+typedef struct {
+    uint32_t sentinel;
+    uint32_t version;
+    uint32_t number_of_keys;
+    crypto_key_mont mont[];
+} __attribute__ ((packed)) crypto_key_ext;
+
+#define CRYPTO_KEY_INDEX_SENTINEL 0x7864696b /* "kidx" */
+
+/**
+ * @brief One slot of a key index
+ *
+ * name_hash is the FNV-1a hash of the key name (up to its NUL, at most
+ * sizeof(key_name) bytes), key the key's table index plus one, or 0 for
+ * an empty slot.
+ */
+typedef struct {
+    uint32_t name_hash;
+    uint32_t key;
+} __attribute__ ((packed)) crypto_key_slot;
+
+/**
+ * @brief Optional hash index over a public key table, by key name
+ *
+ * An open-addressed table: a name starts at slot name_hash %
+ * number_of_slots and probes forward to the first empty slot. There are
+ * more slots than keys (a power of two), so every probe ends. It follows
+ * the crypto_key_ext (or public_keys[] if there is none) in the second
+ * stage config data, and is public_keys_index for the boot ROM table.
+ * Without one, keys are found by walking the table.
+ */
+typedef struct {
+    uint32_t sentinel;
+    uint32_t number_of_keys;
+    uint32_t number_of_slots;
+    crypto_key_slot slots[];
+} __attribute__ ((packed)) crypto_key_index;
+
+#define CRYPTO_KEY_LARGE_SENTINEL 0x67726c6b /* "klrg" */
+
+/**
+ * @brief A public key bigger than crypto_public_key has room for
+ *
+ * An RSA3072 or RSA4096 key, in the first 384 or 512 bytes of key
+ * according to type.
+ */
+typedef struct {
+    uint32_t type;
+    char key_name[96];
+    unsigned char key[RSA_MAX_PUBLIC_KEY_SIZE];
+} __attribute__ ((packed)) crypto_public_key_large;
+
+/**
+ * @brief Optional table of RSA3072/RSA4096 keys
+ *
+ * It follows the crypto_key_index (or whichever of the key table and its
+ * trailers comes last) in the second stage config data. These keys are
+ * found by walking the table, and can only verify later stages.
+ */
+typedef struct {
+    uint32_t sentinel;
+    uint32_t number_of_keys;
+    crypto_public_key_large keys[];
+} __attribute__ ((packed)) crypto_key_large;
+
+/**
+ * @brief A SHA-256 implementation behind hash_start/hash_update/hash_final
+ *
+ * context_size is the space the backend needs for one running hash, and
+ * chunk_size the hash_update length it works best with (loaders size their
+ * reads to a multiple of it where they can).
+ */
+typedef struct hash_backend {
+    uint32_t context_size;
+    uint32_t chunk_size;
+    void (*init)(void *ctx);
+    void (*update)(void *ctx, const unsigned char *data, uint32_t datalen);
+    void (*final)(void *ctx, unsigned char *digest);
+} hash_backend;
+
 extern const crypto_public_key public_keys[];
 extern const uint32_t number_of_public_keys;
+/* Weak so that a PUBLIC_KEYS_FILE without these still links */
+extern const crypto_key_ext public_keys_ext __attribute__ ((weak));
+extern const crypto_key_index public_keys_index __attribute__ ((weak));
 
 void crypto_init(void);
 
 void hash_start(void);
 void hash_update(unsigned char *data, uint32_t datalen);
 void hash_final(unsigned char *digest);
+int hash_final_check(const unsigned char *digest);
+uint32_t hash_chunk_size(void);
+void hash_derive(const unsigned char *seed, const unsigned char *suffixes,
+                 uint32_t count, unsigned char *digests);
 
 #endif /* __COMMON_INCLUDE_CRYPTO_H */
@@ -70,6 +70,7 @@ typedef char ___tftf_sentinel_test[(TFTF_SENTINEL_SIZE ==
 #define TFTF_SECTION_COMPRESSED_CODE      3
 #define TFTF_SECTION_COMPRESSED_DATA      4
 #define TFTF_SECTION_MANIFEST             5
+#define TFTF_SECTION_CHUNK_DIGESTS        6
 #define TFTF_SECTION_SIGNATURE            0x80
 #define TFTF_SECTION_CERTIFICATE          0x81
 
@@ -147,8 +148,13 @@ typedef char ___tftf_header_test[(sizeof(tftf_header) ==
                                  1 : -1];
 
 #define TFTF_SIGNATURE_KEY_NAME_SIZE    96
-#define TFTF_SIGNATURE_SIZE             256
+/* Room for the largest signature, RSA4096 */
+#define TFTF_SIGNATURE_SIZE             512
 
+/*
+ * A signature section holds as much of signature[] as its type needs
+ * (256 bytes for RSA2048), so the section can be shorter than this.
+ */
 typedef struct {
     uint32_t length;            /* total size of tftf_signature structure */
     uint32_t type;              /* Some ALGORITHM_TYPE_xxx from crypto.h */
@@ -156,4 +162,20 @@ typedef struct {
     unsigned char signature[TFTF_SIGNATURE_SIZE];
 } __attribute__ ((packed)) tftf_signature;
 
+/**
+ * @brief Payload of a TFTF_SECTION_CHUNK_DIGESTS section
+ *
+ * The table is the first section. Every section after it that is part of
+ * the signed image is loaded to memory and split into chunk_size pieces (the
+ * last piece of a section may be shorter), and digests[] holds the SHA-256
+ * of each piece in load order. The image signature then covers the header
+ * and this table only, and the table covers the rest, so each byte of the
+ * image is hashed once.
+ */
+typedef struct {
+    uint32_t chunk_size;
+    uint32_t num_chunks;
+    unsigned char digests[][32];
+} __attribute__ ((packed)) tftf_chunk_digests;
+
 #endif /* __COMMON_INCLUDE_TFTF_H */
@@ -32,19 +32,101 @@
 #include "tftf.h"
 #include "debug.h"
 #include "crypto.h"
+#include "chipapi.h"
 #include "2ndstage_cfgdata.h"
 
 #include "../vendors/MIRACL/bootrom.c"
 
 void (*sha256_init_func)(sha256 *sh);
 void (*sha256_process_func)(sha256 *sh,int byte);
+void (*sha256_update_func)(sha256 *sh,const char *buf,int len);
 void (*sha256_hash_func)(sha256 *sh,char hash[32]);
 int (*rsa2048_verify_func)(char digest[], char signature[], char public_key[]);
+int (*rsa2048_verify_mont_func)(char digest[], char public_key[],
+                                char signature[], unsigned int n0inv,
+                                char r2[]);
+int (*rsa_verify_n_func)(char digest[], char public_key[], char signature[],
+                         int len);
 
 #ifndef _NOCRYPTO
+/* The running hash. A backend whose context needs more is not used */
 static sha256 shctx;
 #endif
 
+/* ROMs without SHARED_FUNCTION_EXT_SHA256_UPDATE: one byte at a time */
+static void sha256_update_bytes(sha256 *sh, const char *buf, int len) {
+    int i;
+    for (i = 0; i < len; i++) {
+        sha256_process_func(sh, (unsigned char)buf[i]);
+    }
+}
+
+static void sw_hash_init(void *ctx) {
+    sha256_init_func((sha256 *)ctx);
+}
+
+static void sw_hash_update(void *ctx, const unsigned char *data,
+                           uint32_t datalen) {
+    sha256_update_func((sha256 *)ctx, (const char *)data, (int)datalen);
+}
+
+static void sw_hash_final(void *ctx, unsigned char *digest) {
+    sha256_hash_func((sha256 *)ctx, (char *)digest);
+}
+
+/* Software SHA-256 (the shared shs256_* functions), one block at a time */
+static const hash_backend sw_hash_backend = {
+    .context_size = sizeof(sha256),
+    .chunk_size = 64,
+    .init = sw_hash_init,
+    .update = sw_hash_update,
+    .final = sw_hash_final
+};
+
+#ifdef _HOST_HASH_BACKEND
+/*
+ * Stand-in for a hardware engine, for testing the dispatch on chips without
+ * one: software SHA-256 with an engine-like chunk size. It counts the bytes
+ * it is given and, when the hash is finalised, checks them against the
+ * length in the context, so any byte that reached the hash without going
+ * through the selected backend is reported.
+ */
+static uint32_t host_hash_bytes;
+
+static void host_hash_init(void *ctx) {
+    host_hash_bytes = 0;
+    sw_hash_init(ctx);
+}
+
+static void host_hash_update(void *ctx, const unsigned char *data,
+                             uint32_t datalen) {
+    host_hash_bytes += datalen;
+    sw_hash_update(ctx, data, datalen);
+}
+
+static void host_hash_final(void *ctx, unsigned char *digest) {
+    sha256 *sh = (sha256 *)ctx;
+
+    if (sh->length[1] != 0 || sh->length[0] / 8 != host_hash_bytes) {
+        dbgprintx32("Hash bytes bypassing the backend: ",
+                    sh->length[0] / 8 - host_hash_bytes, "\r\n");
+    } else {
+        dbgprintx32("Hash backend bytes: ", host_hash_bytes, "\r\n");
+    }
+    sw_hash_final(ctx, digest);
+}
+
+static const hash_backend host_hash_backend = {
+    .context_size = sizeof(sha256),
+    .chunk_size = 512,
+    .init = host_hash_init,
+    .update = host_hash_update,
+    .final = host_hash_final
+};
+#endif
+
+static const hash_backend *hash_be = &sw_hash_backend;
+
 /**
  * @brief Initialize the SHA hash
  *
@@ -54,7 +136,7 @@ static sha256 shctx;
  */
 void hash_start(void) {
 #ifndef _NOCRYPTO
-    sha256_init_func(&shctx);
+    hash_be->init(&shctx);
 #endif
 }
 
@@ -69,10 +151,7 @@ void hash_start(void) {
  */
 void hash_update(unsigned char *data, uint32_t datalen) {
 #ifndef _NOCRYPTO
-    uint32_t i;
-    for (i = 0; i < datalen; i++) {
-        sha256_process_func(&shctx, data[i]);
-    }
+    hash_be->update(&shctx, data, datalen);
 #endif
 }
 
@@ -86,61 +165,424 @@ void hash_update(unsigned char *data, uint32_t datalen) {
  */
 void hash_final(unsigned char *digest) {
 #ifndef _NOCRYPTO
-    sha256_hash_func(&shctx,(char*)digest);
+    hash_be->final(&shctx, digest);
+#endif
+}
+
+/**
+ * @brief Finalize the SHA hash and compare it with the expected digest
+ *
+ * @param digest The expected digest
+ *
+ * @returns 0 if the hash matches the digest, non-zero otherwise
+ */
+int hash_final_check(const unsigned char *digest) {
+#ifdef _NOCRYPTO
+    return 0;
+#else
+    unsigned char actual[SHA256_HASH_DIGEST_SIZE];
+
+    hash_final(actual);
+    return memcmp(actual, digest, sizeof(actual)) ? -1 : 0;
+#endif
+}
+
+/**
+ * @brief Get the hash_update length the hash backend works best with
+ *
+ * @returns The preferred length in bytes, a multiple of the SHA block size
+ */
+uint32_t hash_chunk_size(void) {
+    return hash_be->chunk_size;
+}
+
+
+/**
+ * @brief Derive sha256(seed || copy(suffixes[i], 32)) for a run of suffixes
+ *
+ * The seed and one suffix repeated 32 times fill exactly one SHA256 block, so
+ * each suffix costs two transforms: that block, then a precomputed padding
+ * block. Only the seed words are reused between suffixes.
+ * This doesn't touch the hash_start/hash_update/hash_final context.
+ *
+ * @param seed The 32-byte value to derive from
+ * @param suffixes The constant byte for each derivation
+ * @param count Number of suffixes
+ * @param digests Buffer for count * SHA256_HASH_DIGEST_SIZE bytes of output
+ *
+ * @returns Nothing
+ */
+void hash_derive(const unsigned char *seed, const unsigned char *suffixes,
+                 uint32_t count, unsigned char *digests) {
+#ifndef _NOCRYPTO
+    shs256_derive((const char *)seed, (const char *)suffixes, (int)count,
+                  (char *)digests);
 #endif
 }
 
+/**
+ * @brief Get the precomputed Montgomery constants of a key
+ *
+ * @param ext The extension that follows the key table, or NULL
+ * @param number_of_keys The number of keys in the table
+ * @param k Index of the key
+ *
+ * @returns The key's constants, or NULL if the table has none usable
+ */
+static const crypto_key_mont *find_key_mont(const crypto_key_ext *ext,
+                                            uint32_t number_of_keys,
+                                            uint32_t k) {
+    if (ext == NULL ||
+        ext->sentinel != CRYPTO_KEY_EXT_SENTINEL ||
+        ext->version != CRYPTO_KEY_EXT_VERSION ||
+        ext->number_of_keys != number_of_keys) {
+        return NULL;
+    }
+
+    return &ext->mont[k];
+}
+
+#if BOOT_STAGE == 1
+/* Keys chip_is_key_revoked() reported at crypto_init(), one bit per key */
+#define MAX_REVOCABLE_KEYS 32
+static uint32_t revoked_keys;
+#endif
+
+/**
+ * @brief Check whether a key was revoked, without going back to the chip
+ *
+ * @param k Index of the key
+ *
+ * @returns Non-zero if the key must not be used
+ */
+static int is_key_revoked(uint32_t k) {
 #if BOOT_STAGE == 1
-static int find_public_key(tftf_signature *signature, const unsigned char **key) {
+    return k >= MAX_REVOCABLE_KEYS || (revoked_keys & (1u << k)) != 0;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief FNV-1a hash of a key name, as tools/pem2keytable computes it
+ *
+ * @param name The key name
+ * @param len The size of the name field
+ *
+ * @returns The hash of the name up to its NUL, or len bytes if it has none
+ */
+static uint32_t key_name_hash(const char *name, uint32_t len) {
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+
+    for (i = 0; i < len && name[i] != '\0'; i++) {
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Check a key table entry against the key a signature names
+ *
+ * @param key The key table entry
+ * @param k Index of the entry
+ * @param signature The TFTF signature block
+ *
+ * @returns Non-zero if the key is the one to use
+ */
+static int is_signature_key(const crypto_public_key *key, uint32_t k,
+                            tftf_signature *signature) {
+    if (key->type != signature->type ||
+        strncmp(key->key_name, signature->key_name, sizeof(key->key_name))) {
+        return 0;
+    }
+
+    if (is_key_revoked(k)) {
+        dbgprintx32("Key ", k, " revoked\n");
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Get a key table's index, if it has a usable one
+ *
+ * @param index The index that comes with the key table, or NULL
+ * @param number_of_keys The number of keys in the table
+ *
+ * @returns The index, or NULL if the table must be walked instead
+ */
+static const crypto_key_index *find_key_index(const crypto_key_index *index,
+                                              uint32_t number_of_keys) {
+    if (index == NULL ||
+        index->sentinel != CRYPTO_KEY_INDEX_SENTINEL ||
+        index->number_of_keys != number_of_keys ||
+        index->number_of_slots <= number_of_keys ||
+        (index->number_of_slots & (index->number_of_slots - 1)) != 0) {
+        return NULL;
+    }
+
+    return index;
+}
+
+/**
+ * @brief Find the key a signature names in a key table
+ *
+ * @param keys The key table
+ * @param number_of_keys The number of keys in the table
+ * @param index Index over the table, or NULL to walk it
+ * @param signature The TFTF signature block
+ *
+ * @returns The key's table index, or -1 if there is no usable key
+ */
+static int find_key(const crypto_public_key *keys, uint32_t number_of_keys,
+                    const crypto_key_index *index, tftf_signature *signature) {
+    const crypto_key_slot *slot;
+    uint32_t hash;
+    uint32_t mask;
+    uint32_t i;
     uint32_t k;
 
-    for (k = 0; k < number_of_public_keys; k++) {
-        if (chip_is_key_revoked(k)) {
-            dbgprintx32("Key ", k, " revoked\n");
-            continue;
+    if (index == NULL) {
+        for (k = 0; k < number_of_keys; k++) {
+            if (is_signature_key(&keys[k], k, signature)) {
+                return k;
+            }
         }
+        return -1;
+    }
 
-        if (public_keys[k].type != signature->type) {
-            continue;
+    hash = key_name_hash(signature->key_name, sizeof(signature->key_name));
+    mask = index->number_of_slots - 1;
+    for (i = 0; i < index->number_of_slots; i++) {
+        slot = &index->slots[(hash + i) & mask];
+        if (slot->key == 0 || slot->key > number_of_keys) {
+            break;
         }
 
-        if (!strncmp(public_keys[k].key_name,
-                     signature->key_name,
-                     sizeof(public_keys[k].key_name))) {
-            dbgprint("Found pub. key\n");
-            *key = public_keys[k].key;
-            return 0;
+        k = slot->key - 1;
+        if (slot->name_hash == hash &&
+            is_signature_key(&keys[k], k, signature)) {
+            return k;
         }
     }
-
-    dbgprint("Failed to find pub. key\n");
     return -1;
 }
+
+#if BOOT_STAGE != 1
+/**
+ * @brief Locate the optional trailers of the config data key table
+ *
+ * A crypto_key_ext, then a crypto_key_index, then a crypto_key_large, each
+ * only if present and wholly inside S2LCFG_MAX_SIZE.
+ *
+ * @param cfgdata The second stage config data
+ * @param ext Set to the crypto_key_ext, or NULL
+ * @param index Set to the crypto_key_index, or NULL
+ * @param large Set to the crypto_key_large, or NULL
+ *
+ * @returns Nothing
+ */
+static void find_cfgdata_trailers(secondstage_cfgdata *cfgdata,
+                                  const crypto_key_ext **ext,
+                                  const crypto_key_index **index,
+                                  const crypto_key_large **large) {
+    uint32_t n = cfgdata->number_of_public_keys;
+    uint32_t offset;
+    uint32_t size;
+    const crypto_key_ext *e;
+    const crypto_key_index *x;
+    const crypto_key_large *l;
+
+    *ext = NULL;
+    *index = NULL;
+    *large = NULL;
+
+    if (n > S2LCFG_MAX_SIZE / sizeof(crypto_public_key)) {
+        return;
+    }
+    offset = offsetof(secondstage_cfgdata, public_keys) +
+             n * sizeof(crypto_public_key);
+
+    e = (const crypto_key_ext *)((uint8_t *)cfgdata + offset);
+    if (offset + sizeof(*e) <= S2LCFG_MAX_SIZE &&
+        e->sentinel == CRYPTO_KEY_EXT_SENTINEL) {
+        /* Only the version this code knows has a known length */
+        if (e->version != CRYPTO_KEY_EXT_VERSION) {
+            return;
+        }
+        size = sizeof(*e) + n * sizeof(crypto_key_mont);
+        if (offset + size > S2LCFG_MAX_SIZE) {
+            return;
+        }
+        *ext = e;
+        offset += size;
+    }
+
+    x = (const crypto_key_index *)((uint8_t *)cfgdata + offset);
+    if (offset + sizeof(*x) <= S2LCFG_MAX_SIZE &&
+        x->sentinel == CRYPTO_KEY_INDEX_SENTINEL &&
+        x->number_of_slots <= S2LCFG_MAX_SIZE / sizeof(crypto_key_slot) &&
+        offset + sizeof(*x) + x->number_of_slots * sizeof(crypto_key_slot) <=
+        S2LCFG_MAX_SIZE) {
+        *index = x;
+        offset += sizeof(*x) + x->number_of_slots * sizeof(crypto_key_slot);
+    }
+
+    l = (const crypto_key_large *)((uint8_t *)cfgdata + offset);
+    if (offset + sizeof(*l) <= S2LCFG_MAX_SIZE &&
+        l->sentinel == CRYPTO_KEY_LARGE_SENTINEL &&
+        l->number_of_keys <= S2LCFG_MAX_SIZE / sizeof(crypto_public_key_large) &&
+        offset + sizeof(*l) +
+        l->number_of_keys * sizeof(crypto_public_key_large) <=
+        S2LCFG_MAX_SIZE) {
+        *large = l;
+    }
+}
+
+/**
+ * @brief Find the RSA3072/RSA4096 key a signature names
+ *
+ * @param large The table of large keys, or NULL
+ * @param signature The TFTF signature block
+ *
+ * @returns The key, or NULL if there is none
+ */
+static const unsigned char *find_large_key(const crypto_key_large *large,
+                                           tftf_signature *signature) {
+    uint32_t k;
+
+    if (large == NULL) {
+        return NULL;
+    }
+
+    for (k = 0; k < large->number_of_keys; k++) {
+        if (large->keys[k].type == signature->type &&
+            !strncmp(large->keys[k].key_name, signature->key_name,
+                     sizeof(large->keys[k].key_name))) {
+            return large->keys[k].key;
+        }
+    }
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Get the key (and signature) size of a signature type
+ *
+ * @param type Some ALGORITHM_TYPE_xxx
+ *
+ * @returns The size in bytes, or 0 for a type that cannot be verified
+ */
+static uint32_t signature_key_size(uint32_t type) {
+    switch (type) {
+    case ALGORITHM_TYPE_RSA2048_SHA256:
+        return RSA2048_PUBLIC_KEY_SIZE;
+    case ALGORITHM_TYPE_RSA3072_SHA256:
+        return RSA3072_PUBLIC_KEY_SIZE;
+    case ALGORITHM_TYPE_RSA4096_SHA256:
+        return RSA4096_PUBLIC_KEY_SIZE;
+    default:
+        return 0;
+    }
+}
+
+static int find_public_key(tftf_signature *signature, const unsigned char **key,
+                           const crypto_key_mont **mont) {
+    const crypto_public_key *keys;
+    const crypto_key_ext *ext;
+    const crypto_key_index *index;
+    uint32_t n;
+    int k;
+
+    *mont = NULL;
+
+#if BOOT_STAGE == 1
+    keys = public_keys;
+    n = number_of_public_keys;
+    ext = &public_keys_ext;
+    index = &public_keys_index;
 #else
-static int find_public_key(tftf_signature *signature, const unsigned char **key) {
     secondstage_cfgdata *cfgdata;
-    uint32_t k;
 
-    if (!get_2ndstage_cfgdata(&cfgdata)) {
-        for (k = 0; k < cfgdata->number_of_public_keys; k++) {
-            if (cfgdata->public_keys[k].type != signature->type) {
-                continue;
-            }
+    if (get_2ndstage_cfgdata(&cfgdata)) {
+        dbgprint("Failed to find pub. key\n");
+        return -1;
+    }
+    const crypto_key_large *large;
 
-            if (!strncmp(cfgdata->public_keys[k].key_name,
-                        signature->key_name,
-                        sizeof(cfgdata->public_keys[k].key_name))) {
-                dbgprint("Found pub. key\n");
-                *key = cfgdata->public_keys[k].key;
-                return 0;
-            }
+    keys = cfgdata->public_keys;
+    n = cfgdata->number_of_public_keys;
+    find_cfgdata_trailers(cfgdata, &ext, &index, &large);
+
+    if (signature->type != ALGORITHM_TYPE_RSA2048_SHA256) {
+        *key = find_large_key(large, signature);
+        if (*key == NULL) {
+            dbgprint("Failed to find pub. key\n");
+            return -1;
         }
+        dbgprint("Found pub. key\n");
+        return 0;
     }
+#endif
 
-    dbgprint("Failed to find pub. key\n");
-    return -1;
+    k = find_key(keys, n, find_key_index(index, n), signature);
+    if (k < 0) {
+        dbgprint("Failed to find pub. key\n");
+        return -1;
+    }
+
+    dbgprint("Found pub. key\n");
+    *key = keys[k].key;
+    *mont = find_key_mont(ext, n, k);
+    return 0;
+}
+
+/**
+ * @brief Find the key and size for verifying a signature
+ *
+ * @param signature The TFTF signature block (only type and key_name are used)
+ * @param size Set to the key and signature size
+ * @param key Set to the public key
+ * @param mont Set to the key's Montgomery constants, or NULL
+ *
+ * @returns 0 if the signature has a key that is present, not revoked and of a
+ *          type this stage can verify, -1 otherwise
+ */
+static int find_signature_key(tftf_signature *signature, uint32_t *size,
+                              const unsigned char **key,
+                              const crypto_key_mont **mont) {
+    *size = signature_key_size(signature->type);
+    if (*size == 0 ||
+        (*size != RSA2048_PUBLIC_KEY_SIZE && rsa_verify_n_func == NULL)) {
+        dbgprint("Unsupported signature type\n");
+        return -1;
+    }
+
+    return find_public_key(signature, key, mont);
 }
+
+/**
+ * @brief Check whether a signature could be verified at all
+ *
+ * Lets a loader skip the signature bytes and the RSA work for signatures
+ * with an unknown or revoked key, or of an unsupported type.
+ *
+ * @param signature The TFTF signature block. Only type and key_name have to
+ *        be loaded.
+ *
+ * @returns 0 if verify_signature() has a key for it, -1 otherwise
+ */
+int check_signature_key(tftf_signature *signature) {
+#ifdef _NOCRYPTO
+    return 0;
 #endif
+    uint32_t size;
+    const unsigned char *public_key;
+    const crypto_key_mont *mont;
+
+    return find_signature_key(signature, &size, &public_key, &mont);
+}
 
 /**
  * @brief Verify a SHA digest against a signature
@@ -161,15 +603,30 @@ int verify_signature(unsigned char *digest, tftf_signature *signature) {
     return 0;
 #endif
     int ret;
+    uint32_t size;
     const unsigned char *public_key;
+    const crypto_key_mont *mont;
 
-    if (find_public_key(signature, &public_key)) {
+    if (find_signature_key(signature, &size, &public_key, &mont)) {
         return -1;
     }
 
-    ret = rsa2048_verify_func((char *)digest,
-                              (char *)public_key,
-                              (char *)signature->signature) ? 0 : -1;
+    if (size != RSA2048_PUBLIC_KEY_SIZE) {
+        ret = rsa_verify_n_func((char *)digest,
+                                (char *)public_key,
+                                (char *)signature->signature,
+                                size) ? 0 : -1;
+    } else if (mont != NULL && rsa2048_verify_mont_func != NULL) {
+        ret = rsa2048_verify_mont_func((char *)digest,
+                                       (char *)public_key,
+                                       (char *)signature->signature,
+                                       mont->n0inv,
+                                       (char *)mont->r2) ? 0 : -1;
+    } else {
+        ret = rsa2048_verify_func((char *)digest,
+                                  (char *)public_key,
+                                  (char *)signature->signature) ? 0 : -1;
+    }
 
     if (ret) {
         dbgprint("Signature failed\n");
@@ -189,15 +646,63 @@ int verify_signature(unsigned char *digest, tftf_signature *signature) {
     return ret;
 }
 
+/**
+ * @brief Pick the hash backend: the chip's engine if it has a usable one,
+ * software SHA-256 otherwise
+ *
+ * @returns Nothing
+ */
+static void hash_select_backend(void) {
+#ifndef _NOCRYPTO
+#ifdef _HOST_HASH_BACKEND
+    const hash_backend *be = &host_hash_backend;
+#else
+    const hash_backend *be = chip_hash_backend();
+#endif
+
+    if (be != NULL && be->context_size <= sizeof(shctx)) {
+        hash_be = be;
+        return;
+    }
+#endif
+    hash_be = &sw_hash_backend;
+}
+
 void crypto_init(void) {
 #if BOOT_STAGE == 1
+    uint32_t k;
+
+    revoked_keys = 0;
+    for (k = 0; k < number_of_public_keys && k < MAX_REVOCABLE_KEYS; k++) {
+        if (chip_is_key_revoked(k)) {
+            revoked_keys |= 1u << k;
+        }
+    }
+
     set_shared_function(SHARED_FUNCTION_SHA256_INIT, shs256_init);
     set_shared_function(SHARED_FUNCTION_SHA256_PROCESS, shs256_process);
     set_shared_function(SHARED_FUNCTION_SHA256_HASH, shs256_hash);
     set_shared_function(SHARED_FUNCTION_RSA2048_VERIFY, rsa_verify);
+
+    init_shared_functions_ext();
+    set_shared_function_ext(SHARED_FUNCTION_EXT_SHA256_UPDATE, shs256_update);
+    set_shared_function_ext(SHARED_FUNCTION_EXT_RSA2048_VERIFY_MONT,
+                            rsa_verify_mont);
+    set_shared_function_ext(SHARED_FUNCTION_EXT_RSA_VERIFY_N, rsa_verify_n);
 #endif
     sha256_init_func = get_shared_function(SHARED_FUNCTION_SHA256_INIT);
     sha256_process_func = get_shared_function(SHARED_FUNCTION_SHA256_PROCESS);
+    sha256_update_func =
+        get_shared_function_ext(SHARED_FUNCTION_EXT_SHA256_UPDATE);
+    if (sha256_update_func == NULL) {
+        sha256_update_func = sha256_update_bytes;
+    }
     sha256_hash_func = get_shared_function(SHARED_FUNCTION_SHA256_HASH);
     rsa2048_verify_func = get_shared_function(SHARED_FUNCTION_RSA2048_VERIFY);
+    rsa2048_verify_mont_func =
+        get_shared_function_ext(SHARED_FUNCTION_EXT_RSA2048_VERIFY_MONT);
+    rsa_verify_n_func =
+        get_shared_function_ext(SHARED_FUNCTION_EXT_RSA_VERIFY_N);
+
+    hash_select_backend();
 }
@@ -101,6 +101,11 @@ void sha256_concat(uint8_t *input,
                    uint8_t *output) {
     uint32_t i;
 
+    if (num_to_concat == SHA256_HASH_DIGEST_SIZE) {
+        hash_derive(input, &val_to_concat, 1, output);
+        return;
+    }
+
     hash_start();
     hash_update(input, SHA256_HASH_DIGEST_SIZE);
     for (i = 0; i < num_to_concat; i++) {;
@@ -286,17 +286,24 @@ protocol_error:
 static int data_load_greybus_load(void *dest, uint32_t length, bool hash) {
     int rc;
     uint32_t blk_len, prev_len = 0;
+    uint32_t max_len = GB_MAX_PAYLOAD_SIZE;
     void *prev = NULL;
     if (offset + length > firmware_size) {
         return GB_BOOT_ERR_INVALID;
     }
 
+    if (hash && hash_chunk_size() <= max_len) {
+        max_len -= max_len % hash_chunk_size();
+    }
+
     while (length) {
         /**
          * We take whichever is smaller: the largest possible size for a Greybus
          * message payload, or the remaining length of the firmware blob.
+         * When hashing, the payload is trimmed to whole hash chunks so the
+         * backend is fed aligned blocks while the next request is in flight.
          */
-        blk_len = (length > GB_MAX_PAYLOAD_SIZE) ? GB_MAX_PAYLOAD_SIZE : length;
+        blk_len = (length > max_len) ? max_len : length;
         rc = gbboot_get_firmware(offset, blk_len, dest, prev, prev_len);
         if (rc) {
             set_last_error(BRE_BOU_GBBOOT_GET_FW);
@@ -320,6 +327,26 @@ static int data_load_greybus_load(void *dest, uint32_t length, bool hash) {
     return 0;
 }
 
+static int data_load_greybus_rewind(uint32_t length) {
+    if (offset < 0 || length > (uint32_t)offset) {
+        return GB_BOOT_ERR_INVALID;
+    }
+
+    /* the next get-firmware request asks the AP for the same data again */
+    offset -= length;
+    return 0;
+}
+
+static int data_load_greybus_skip(uint32_t length) {
+    if (offset < 0 || offset + length > firmware_size) {
+        return GB_BOOT_ERR_INVALID;
+    }
+
+    /* the AP is asked for data by offset, so nothing needs to be fetched */
+    offset += length;
+    return 0;
+}
+
 static int data_load_greybus_finish(bool valid, bool is_secure_image) {
     int rc;
     uint8_t status = GB_BOOT_BOOT_STATUS_INVALID;
@@ -345,5 +372,7 @@ data_load_ops greybus_ops = {
     .init = data_load_greybus_init,
     .read = NULL,
     .load = data_load_greybus_load,
+    .rewind = data_load_greybus_rewind,
+    .skip = data_load_greybus_skip,
     .finish = data_load_greybus_finish
 };
@@ -27,6 +27,7 @@
  */
 
 #include <stddef.h>
+#include <stdbool.h>
 #include <string.h>
 #include <errno.h>
 #include "bootrom.h"
@@ -54,6 +55,12 @@ typedef char ___ergs_test[(sizeof(((secret_keys_comm_area *)NULL)->ergs) ==
 typedef char ___essk_test[(sizeof(((secret_keys_comm_area *)NULL)->errk_n) ==
                            RSA2048_PUBLIC_KEY_SIZE) ?
                           1 : -1];
+typedef char ___epvk_test[(sizeof(((secret_keys_comm_area *)NULL)->epvk) ==
+                           2 * MCL_EFS1 + 1) ?
+                          1 : -1];
+typedef char ___esvk_test[(sizeof(((secret_keys_comm_area *)NULL)->esvk) ==
+                           2 * MCL_EFS2 + 1) ?
+                          1 : -1];
 
 #if DBG_SECRET_KEY_MSG
 /**
@@ -106,29 +113,27 @@ static void calculate_y2(uint8_t *ims, uint8_t *y2) {
     hash_final(y2);
 }
 
-static void calculate_epsk(uint8_t *y2, uint8_t *epsk) {
-    uint8_t z1[SHA256_HASH_DIGEST_SIZE];
-    uint8_t t[SHA256_HASH_DIGEST_SIZE];
+/* Suffix bytes for the sha256(X || copy(n, 32)) derivations */
+static const uint8_t key_suffixes[] = {0x01, 0x02, 0x03, 0x04,
+                                       0x05, 0x06, 0x07, 0x08};
 
-    /* Z1 = sha256(Y2 || copy(0x01, 32)) */
-    sha256_concat(y2, 0x01, 32, z1);
+/* Z1..Z5 are derived from Y2 in one pass, ZN is z[N - 1] */
+#define NUM_Z 5
 
-    /* EPSK[0:31] = sha256(Z1 || copy(0x01, 32)) */
-    sha256_concat(z1, 0x01, 32, epsk);
+static void calculate_epsk(uint8_t *z1, uint8_t *epsk) {
+    uint8_t t[2 * SHA256_HASH_DIGEST_SIZE];
 
-    /* EPSK[32:51] = sha256(Z1 || copy(0x02, 32))[0:19] */
-    sha256_concat(z1, 0x02, 32, t);
-    memcpy(&epsk[32], t, 24);
+    /**
+     * EPSK[0:31] = sha256(Z1 || copy(0x01, 32))
+     * EPSK[32:51] = sha256(Z1 || copy(0x02, 32))[0:19]
+     */
+    hash_derive(z1, &key_suffixes[0], 2, t);
+    memcpy(epsk, t, SHA256_HASH_DIGEST_SIZE + 24);
 }
 
-static void calculate_essk(uint8_t *y2, uint8_t *essk) {
-    uint8_t z2[SHA256_HASH_DIGEST_SIZE];
-
-    /* Z2 = sha256(Y2 || copy(0x02, 32)) */
-    sha256_concat(y2, 0x02, 32, z2);
-
+static void calculate_essk(uint8_t *z2, uint8_t *essk) {
     /* ESSK[0:31] = sha256(Z2 || copy(0x01, 32)) */
-    sha256_concat(z2, 0x01, 32, essk);
+    hash_derive(z2, &key_suffixes[0], 1, essk);
 }
 
 static void bytes_to_MCL_FF(uint8_t *buf, size_t len,
@@ -174,16 +179,23 @@ static void MCL_FF_to_bytes(mcl_chunk ff[][MCL_NLEN1], int n,
 
 #define ERRK_ALIAS_MOD_BITS 3
 #define ERRK_ALIAS_MOD_SHIFT 2
-static void calculate_errk(uint8_t *y2, uint8_t *ims, uint8_t *errk_n) {
-    uint8_t z3[SHA256_HASH_DIGEST_SIZE];
+#define ERRK_E 65537
+
+/**
+ * ERRK private key. It lives in stage 2's own data and is never copied to the
+ * communication area. key_generation() fills in p and q, the CRT parameters
+ * dp, dq and c are derived by errk_private_key() on first use.
+ */
+static MCL_rsa_private_key_RSA2048 errk_priv;
+static bool errk_valid;
+static bool errk_crt_valid;
+
+static void calculate_errk(uint8_t *z3, uint8_t *ims, uint8_t *errk_n) {
     MCL_rsa_public_key_RSA2048 pub;
-    MCL_rsa_private_key_RSA2048 priv;
+    MCL_rsa_private_key_RSA2048 *priv = &errk_priv;
     uint8_t errk_p[RSA2048_PUBLIC_KEY_SIZE/2];
     uint8_t errk_q[RSA2048_PUBLIC_KEY_SIZE/2];
 
-    /* Z3 = sha256(Y2 || copy(0x03, 32)) */
-    sha256_concat(y2, 0x03, 32, z3);
-
     /**
      * ERRK_P[0:31] = sha256(Z3 || copy(0x01, 32))
      * ERRK_P[32:63] = sha256(Z3 || copy(0x02, 32))
@@ -191,13 +203,10 @@ static void calculate_errk(uint8_t *y2, uint8_t *ims, uint8_t *errk_n) {
      * ERRK_P[96:127] = sha256(Z3 || copy(0x04, 32))
      * ERRK_P[0] |= 0x03
      */
-    sha256_concat(z3, 0x01, 32, &errk_p[0]);
-    sha256_concat(z3, 0x02, 32, &errk_p[32]);
-    sha256_concat(z3, 0x03, 32, &errk_p[64]);
-    sha256_concat(z3, 0x04, 32, &errk_p[96]);
+    hash_derive(z3, &key_suffixes[0], 4, errk_p);
     errk_p[0] |= ERRK_ALIAS_MOD_BITS;
 
-    bytes_to_MCL_FF(errk_p, RSA2048_PUBLIC_KEY_SIZE/2, priv.p, MCL_FFLEN1/2);
+    bytes_to_MCL_FF(errk_p, RSA2048_PUBLIC_KEY_SIZE/2, priv->p, MCL_FFLEN1/2);
 
     /**
      * ERRK_Q[0:31] = sha256(Z3 || copy(0x05, 32))
@@ -206,31 +215,28 @@ static void calculate_errk(uint8_t *y2, uint8_t *ims, uint8_t *errk_n) {
      * ERRK_Q[96:127] = sha256(Z3 || copy(0x08, 32))
      * ERRK_Q[0] |= 0x03
      */
-    sha256_concat(z3, 0x05, 32, &errk_q[0]);
-    sha256_concat(z3, 0x06, 32, &errk_q[32]);
-    sha256_concat(z3, 0x07, 32, &errk_q[64]);
-    sha256_concat(z3, 0x08, 32, &errk_q[96]);
+    hash_derive(z3, &key_suffixes[4], 4, errk_q);
     errk_q[0] |= ERRK_ALIAS_MOD_BITS;
 
-    bytes_to_MCL_FF(errk_q, RSA2048_PUBLIC_KEY_SIZE/2, priv.q, MCL_FFLEN1/2);
+    bytes_to_MCL_FF(errk_q, RSA2048_PUBLIC_KEY_SIZE/2, priv->q, MCL_FFLEN1/2);
 
     /* ERRK_P += 4 * IMS[34:32] / 4096 */
     /* ERRK_Q += 4 * IMS[34:32] % 4096 */
     uint32_t alias_ims = (*((uint32_t *)&ims[32]) & 0x00FFFFFF);
-    MCL_FF_inc_C448(priv.p,
+    MCL_FF_inc_C448(priv->p,
                     (alias_ims >> 12) << ERRK_ALIAS_MOD_SHIFT,
                     MCL_FFLEN1/2);
-    MCL_FF_inc_C448(priv.q,
+    MCL_FF_inc_C448(priv->q,
                     (alias_ims & 0xFFF) << ERRK_ALIAS_MOD_SHIFT,
                     MCL_FFLEN1/2);
 
 #if DBG_SECRET_KEY_MSG
-    ff_dump(priv.p, MCL_FFLEN1/2, "p ");
-    ff_dump(priv.q, MCL_FFLEN1/2, "q ");
+    ff_dump(priv->p, MCL_FFLEN1/2, "p ");
+    ff_dump(priv->q, MCL_FFLEN1/2, "q ");
 #endif
 
     /* ERPK_MOD = ERRK_Q * ERRK_P */
-    MCL_FF_mul_C448(pub.n, priv.p, priv.q, MCL_FFLEN1/2);
+    MCL_FF_mul_C448(pub.n, priv->p, priv->q, MCL_FFLEN1/2);
 
 #if DBG_SECRET_KEY_MSG
     ff_dump(pub.n, MCL_FFLEN1, "n ");
@@ -241,30 +247,156 @@ static void calculate_errk(uint8_t *y2, uint8_t *ims, uint8_t *errk_n) {
                     errk_n,
                     RSA2048_PUBLIC_KEY_SIZE);
     /* ERPK_E = 65537 */
-    pub.e = 65537;
+    pub.e = ERRK_E;
 
-    /* TBD: do we even need the private key on the bridge side? */
-    /* ERRK_D = RSA_secret(ERRK_P, ERRK_Q, ERPK_E) */
+    errk_valid = true;
+    errk_crt_valid = false;
 }
 
-static void calculate_epck(uint8_t *y2, uint8_t *epck) {
-    uint8_t z4[SHA256_HASH_DIGEST_SIZE];
+/**
+ * @brief d = e^-1 mod (p - 1), for a prime p = 3 mod 4
+ *
+ * As in MCL_RSA_KEY_PAIR, (p - 1) / 2 is odd, so the inverse mod (p - 1) / 2
+ * made odd is also the inverse mod p - 1.
+ */
+static void errk_crt_exponent(mcl_chunk d[][MCL_NLEN1],
+                              mcl_chunk p[][MCL_NLEN1]) {
+    mcl_chunk t[MCL_FFLEN1/2][MCL_NLEN1];
+
+    MCL_FF_copy_C448(t, p, MCL_FFLEN1/2);
+    MCL_FF_dec_C448(t, 1, MCL_FFLEN1/2);
+    MCL_FF_shr_C448(t, MCL_FFLEN1/2);
+    MCL_FF_init_C448(d, ERRK_E, MCL_FFLEN1/2);
+    MCL_FF_invmodp_C448(d, d, t, MCL_FFLEN1/2);
+    if (MCL_FF_parity_C448(d) == 0) {
+        MCL_FF_add_C448(d, d, t, MCL_FFLEN1/2);
+    }
+    MCL_FF_norm_C448(d, MCL_FFLEN1/2);
+}
 
-    /* Z4 = sha256(Y2 || copy(0x04, 32)) */
-    sha256_concat(y2, 0x04, 32, z4);
+/**
+ * @brief Get the ERRK private key in CRT form
+ *
+ * ERRK_D is never formed: the private key operations in MCL_RSA_DECRYPT work
+ * mod ERRK_P and ERRK_Q with half size exponents, which is about 3x faster
+ * than one exponentiation mod ERRK_N. The three inversions are done here on
+ * first use, so boots that never use ERRK do not pay for them.
+ *
+ * @returns The private key, or NULL if key_generation() has not run
+ */
+static MCL_rsa_private_key_RSA2048 *errk_private_key(void) {
+    if (!errk_valid) {
+        return NULL;
+    }
 
-    /* EPCK = sha256(Z4 || copy(0x01, 32)) */
-    sha256_concat(z4, 0x01, 32, epck);
+    if (!errk_crt_valid) {
+        errk_crt_exponent(errk_priv.dp, errk_priv.p);
+        errk_crt_exponent(errk_priv.dq, errk_priv.q);
+        /* c = ERRK_P^-1 mod ERRK_Q */
+        MCL_FF_invmodp_C448(errk_priv.c, errk_priv.p, errk_priv.q,
+                            MCL_FFLEN1/2);
+        errk_crt_valid = true;
+    }
+    return &errk_priv;
 }
 
-static void calculate_ergs(uint8_t *y2, uint8_t *ergs) {
-    uint8_t z5[SHA256_HASH_DIGEST_SIZE];
+/**
+ * @brief out = in^ERRK_D mod ERRK_N
+ *
+ * in and out are big endian and ERRK_N_SIZE long. The MCL FFs are wider than
+ * ERRK_N, so the value is zero extended to MCL_RFS1 bytes on the way in and
+ * the extra leading zeros are dropped on the way out.
+ */
+static int errk_private_op(const uint8_t *in, uint8_t *out) {
+    communication_area *pcomm = (communication_area *)&_communication_area;
+    secret_keys_comm_area *key_comm = &(pcomm->second_stage.keys);
+    MCL_rsa_private_key_RSA2048 *priv = errk_private_key();
+    mcl_chunk x[MCL_FFLEN1][MCL_NLEN1];
+    mcl_chunk n[MCL_FFLEN1][MCL_NLEN1];
+    char g[MCL_RFS1];
+    char f[MCL_RFS1];
+    mcl_octet G = {sizeof(g), sizeof(g), g};
+    mcl_octet F = {0, sizeof(f), f};
+
+    if (priv == NULL) {
+        return -ENOENT;
+    }
+
+    memset(g, 0, sizeof(g) - ERRK_N_SIZE);
+    memcpy(&g[sizeof(g) - ERRK_N_SIZE], in, ERRK_N_SIZE);
+
+    /* CRT only gives the right answer for in < ERRK_N */
+    MCL_FF_fromOctet_C448(x, &G, MCL_FFLEN1);
+    bytes_to_MCL_FF(key_comm->errk_n, ERRK_N_SIZE, n, MCL_FFLEN1);
+    if (MCL_FF_comp_C448(x, n, MCL_FFLEN1) >= 0) {
+        return -ERANGE;
+    }
+
+    MCL_RSA_DECRYPT_RSA2048(priv, &G, &F);
+    memcpy(out, &f[sizeof(f) - ERRK_N_SIZE], ERRK_N_SIZE);
+
+    MCL_FF_zero_C448(x, MCL_FFLEN1);
+    memset(f, 0, sizeof(f));
+    return 0;
+}
 
-    /* Z5 = sha256(Y2 || copy(0x05, 32)) */
-    sha256_concat(y2, 0x05, 32, z5);
+static void calculate_epck(uint8_t *z4, uint8_t *epck) {
+    /* EPCK = sha256(Z4 || copy(0x01, 32)) */
+    hash_derive(z4, &key_suffixes[0], 1, epck);
+}
 
+static void calculate_ergs(uint8_t *z5, uint8_t *ergs) {
     /* ERGS = sha256(Z5 || copy(0x01, 32)) */
-    sha256_concat(z5, 0x01, 32, ergs);
+    hash_derive(z5, &key_suffixes[0], 1, ergs);
+}
+
+int get_epvk(uint8_t *pk, size_t pk_size) {
+    communication_area *pcomm = (communication_area *)&_communication_area;
+    secret_keys_comm_area *key_comm = &(pcomm->second_stage.keys);
+
+    if (pk == NULL || pk_size < EPVK_SIZE) {
+        return -EINVAL;
+    }
+    if (!(key_comm->keys_valid & SECRET_KEYS_VALID)) {
+        return -ENOENT;
+    }
+
+    if (!(key_comm->keys_valid & EPVK_VALID)) {
+        mcl_octet S = {EPSK_SIZE, EPSK_SIZE, (char *)key_comm->epsk};
+        mcl_octet W = {0, EPVK_SIZE, (char *)key_comm->epvk};
+
+        /* With no RNG, the private key is taken from S */
+        if (MCL_ECP_KEY_PAIR_GENERATE_C448(NULL, &S, &W) != 0) {
+            return -ERANGE;
+        }
+        key_comm->keys_valid |= EPVK_VALID;
+    }
+    memcpy(pk, key_comm->epvk, EPVK_SIZE);
+    return 0;
+}
+
+int get_esvk(uint8_t *pk, size_t pk_size) {
+    communication_area *pcomm = (communication_area *)&_communication_area;
+    secret_keys_comm_area *key_comm = &(pcomm->second_stage.keys);
+
+    if (pk == NULL || pk_size < ESVK_SIZE) {
+        return -EINVAL;
+    }
+    if (!(key_comm->keys_valid & SECRET_KEYS_VALID)) {
+        return -ENOENT;
+    }
+
+    if (!(key_comm->keys_valid & ESVK_VALID)) {
+        mcl_octet S = {ESSK_SIZE, ESSK_SIZE, (char *)key_comm->essk};
+        mcl_octet W = {0, ESVK_SIZE, (char *)key_comm->esvk};
+
+        if (MCL_ECP_KEY_PAIR_GENERATE_C25519(NULL, &S, &W) != 0) {
+            return -ERANGE;
+        }
+        key_comm->keys_valid |= ESVK_VALID;
+    }
+    memcpy(pk, key_comm->esvk, ESVK_SIZE);
+    return 0;
 }
 
 void initialize_csprng(csprng *RNG) {
@@ -328,17 +460,64 @@ int sign_message_with_essk(uint8_t *message, size_t len,
     return 0;
 }
 
+/* DER encoded DigestInfo header for SHA-256, RFC 3447 section 9.2 */
+static const uint8_t sha256_digest_info[] = {
+    0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+    0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20
+};
+
+int sign_message_with_errk(uint8_t *message, size_t len,
+                           uint8_t *sig, size_t sig_size) {
+    uint8_t em[ERRK_N_SIZE];
+    size_t ps_len = ERRK_N_SIZE - 3 - sizeof(sha256_digest_info) -
+                    SHA256_HASH_DIGEST_SIZE;
+
+    if (sig == NULL || sig_size < ERRK_N_SIZE) {
+        return -EINVAL;
+    }
+
+    /* EM = 0x00 || 0x01 || PS (0xff...) || 0x00 || DigestInfo || H */
+    em[0] = 0x00;
+    em[1] = 0x01;
+    memset(&em[2], 0xff, ps_len);
+    em[2 + ps_len] = 0x00;
+    memcpy(&em[3 + ps_len], sha256_digest_info, sizeof(sha256_digest_info));
+
+    hash_start();
+    hash_update(message, len);
+    hash_final(&em[ERRK_N_SIZE - SHA256_HASH_DIGEST_SIZE]);
+
+    return errk_private_op(em, sig);
+}
+
+int decrypt_with_errk(uint8_t *ciphertext, size_t len,
+                      uint8_t *plaintext, size_t plaintext_size) {
+    if (ciphertext == NULL || len != ERRK_N_SIZE ||
+        plaintext == NULL || plaintext_size < ERRK_N_SIZE) {
+        return -EINVAL;
+    }
+
+    return errk_private_op(ciphertext, plaintext);
+}
+
 void key_generation(uint8_t *ims) {
     communication_area *pcomm = (communication_area *)&_communication_area;
     secret_keys_comm_area *key_comm = &(pcomm->second_stage.keys);
     uint8_t y2[SHA256_HASH_DIGEST_SIZE];
+    uint8_t z[NUM_Z][SHA256_HASH_DIGEST_SIZE];
     uint8_t epck[SHA256_HASH_DIGEST_SIZE];
 
+    /* Anything cached belongs to whatever was here before */
+    key_comm->keys_valid = 0;
+
     calculate_y2(ims, y2);
 
-    calculate_epsk(y2, key_comm->epsk);
-    calculate_ergs(y2, key_comm->ergs);
-    calculate_essk(y2, key_comm->essk);
+    /* ZN = sha256(Y2 || copy(N, 32)), N = 1..5 */
+    hash_derive(y2, key_suffixes, NUM_Z, z[0]);
+
+    calculate_epsk(z[0], key_comm->epsk);
+    calculate_ergs(z[4], key_comm->ergs);
+    calculate_essk(z[1], key_comm->essk);
 
 #if DBG_SECRET_KEY_MSG
     dbgprinthexbuf(key_comm->epsk, sizeof(key_comm->epsk), "epsk ");
@@ -346,7 +525,7 @@ void key_generation(uint8_t *ims) {
     dbgprinthexbuf(key_comm->ergs, sizeof(key_comm->ergs), "ergs ");
 #endif
 
-    calculate_epck(y2, epck);
+    calculate_epck(z[3], epck);
 
     /**
      * To re-create the public key from the communication area, use
@@ -356,7 +535,8 @@ void key_generation(uint8_t *ims) {
      *                     MCL_FFLEN1);
      *     pub.e = 65537;
      */
-    calculate_errk(y2, ims, key_comm->errk_n);
+    calculate_errk(z[2], ims, key_comm->errk_n);
+    key_comm->keys_valid = SECRET_KEYS_VALID;
 
     dbgprint("secret keys generated\n");
 }
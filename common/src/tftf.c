@@ -70,6 +70,9 @@ typedef struct {
     unsigned char hash[SHA256_HASH_DIGEST_SIZE];
     tftf_signature signature;
     bool contain_signature;
+    /* chunk digest table, once its section has been loaded */
+    tftf_chunk_digests *chunks;
+    uint32_t next_chunk;
 } tftf_processing_state;
 
 static tftf_processing_state tftf;
@@ -90,9 +93,12 @@ static int load_tftf_header(data_load_ops *ops) {
     uint32_t unipro_pid = 0;
     int rc;
     tftf_header * header = &tftf.header;
+    bool chunk_table_found = false;
 
     tftf.crypto_state = CRYPTO_STATE_INIT;
     tftf.contain_signature = false;
+    tftf.chunks = NULL;
+    tftf.next_chunk = 0;
 
     /* load the beginning of the TFTF header */
     if (ops->load(&header->buffer[0], TFTF_HEADER_SIZE_MIN, false)) {
@@ -207,11 +213,27 @@ static int load_tftf_header(data_load_ops *ops) {
             set_last_error(BRE_TFTF_COMPRESSION_UNSUPPORTED);
             return -1;
 
+        case TFTF_SECTION_CHUNK_DIGESTS:
+            /* One table, first, and it has to be kept in memory */
+            if (section != &header->sections[0] ||
+                section->section_load_address == DATA_ADDRESS_TO_BE_IGNORED ||
+                section->section_length < sizeof(tftf_chunk_digests)) {
+                set_last_error(BRE_TFTF_CHUNK_TABLE);
+                return -1;
+            }
+            chunk_table_found = true;
+            /* fall through */
         default:
             if (tftf.crypto_state == CRYPTO_STATE_HASHING) {
                 set_last_error(BRE_TFTF_HASHED_SECTION_AFTER_UNHASHED);
                 return -1;
             }
+            /* The table only covers what is kept in memory */
+            if (chunk_table_found &&
+                section->section_load_address == DATA_ADDRESS_TO_BE_IGNORED) {
+                set_last_error(BRE_TFTF_CHUNK_TABLE);
+                return -1;
+            }
             break;
         }
         section++;
@@ -222,11 +244,9 @@ static int load_tftf_header(data_load_ops *ops) {
 }
 
 #define TEMP_BUFFER_SIZE 2048
-static int discard_section(data_load_ops *ops,
-                           tftf_section_descriptor *section,
+static int discard_section(data_load_ops *ops, uint32_t len,
                            bool hash_section) {
     unsigned char temp[TEMP_BUFFER_SIZE];
-    uint32_t len = section->section_length;
     uint32_t blk_len;
 
     while (len) {
@@ -240,6 +260,149 @@ static int discard_section(data_load_ops *ops,
     return 0;
 }
 
+/**
+ * @brief Step over unhashed section data without keeping it
+ *
+ * Uses the loading method's skip when it has one, so the data is not
+ * transferred at all.
+ *
+ * @param ops Pointer to the media access V-table
+ * @param len The number of bytes to step over
+ *
+ * @returns 0 if successful, -1 otherwise
+ */
+static int skip_section(data_load_ops *ops, uint32_t len) {
+    if (len == 0) {
+        return 0;
+    }
+    if (ops->skip != NULL) {
+        return ops->skip(len);
+    }
+    return discard_section(ops, len, false);
+}
+
+/**
+ * @brief Load a signature section and verify the image hash with it
+ *
+ * One good signature is enough, so once one has verified the remaining
+ * signature sections are skipped whole. Before that, only the type and key
+ * name are loaded at first: the signature itself is loaded and checked only
+ * if there is a key that could verify it.
+ *
+ * @param ops Pointer to the media access V-table
+ * @param section The signature section descriptor
+ *
+ * @returns 0 if the section was processed, whether or not it verified,
+ *          -1 if it could not be loaded
+ */
+static int load_signature_section(data_load_ops *ops,
+                                  tftf_section_descriptor *section) {
+    unsigned char *sig = (unsigned char *)&tftf.signature;
+    uint32_t head = offsetof(tftf_signature, signature);
+    uint32_t len;
+
+    if (tftf.crypto_state != CRYPTO_STATE_HASHED) {
+        /* already verified */
+        if (skip_section(ops, section->section_length)) {
+            goto load_error;
+        }
+        return 0;
+    }
+
+    /*
+     * The section holds only as much signature as its type needs. Zero
+     * the rest, so a short section cannot pass for a longer signature.
+     */
+    len = section->section_length;
+    if (len > sizeof(tftf.signature)) {
+        len = sizeof(tftf.signature);
+    }
+    if (head > len) {
+        head = len;
+    }
+    memset(&tftf.signature, 0, sizeof(tftf.signature));
+    if (head != 0 && ops->load(sig, head, false)) {
+        goto load_error;
+    }
+
+    if (check_signature_key(&tftf.signature)) {
+        /* nothing could verify it, so don't fetch the signature */
+        if (skip_section(ops, section->section_length - head)) {
+            goto load_error;
+        }
+        return 0;
+    }
+
+    if ((len != head && ops->load(sig + head, len - head, false)) ||
+        skip_section(ops, section->section_length - len)) {
+        goto load_error;
+    }
+    if (verify_signature(tftf.hash, &tftf.signature) == 0) {
+        tftf.crypto_state = CRYPTO_STATE_VERIFIED;
+    }
+    return 0;
+
+load_error:
+    set_last_error(BRE_TFTF_LOAD_SIGNATURE);
+    return -1;
+}
+
+#define TFTF_CHUNK_RETRIES 2
+/**
+ * @brief Load a section a chunk at a time, checking each against the table
+ *
+ * The image hash ended with the table, so each chunk is hashed on its own as
+ * it loads and compared with its table entry. A mismatch means the image
+ * can't verify either, so rather than reading the rest of the image first,
+ * fetch the chunk again if the loading method can rewind, or give up
+ * straight away.
+ *
+ * @param ops Pointer to the media access V-table
+ * @param dest Where to load the section
+ * @param len The section length
+ *
+ * @returns 0 if successful, -1 otherwise
+ */
+static int load_chunked_section(data_load_ops *ops, unsigned char *dest,
+                                uint32_t len) {
+    uint32_t blk_len;
+    int retries;
+
+    while (len) {
+        blk_len = (len > tftf.chunks->chunk_size) ?
+                  tftf.chunks->chunk_size : len;
+        if (tftf.next_chunk >= tftf.chunks->num_chunks) {
+            set_last_error(BRE_TFTF_CHUNK_TABLE);
+            return -1;
+        }
+
+        retries = TFTF_CHUNK_RETRIES;
+        while (1) {
+            hash_start();
+            if (ops->load(dest, blk_len, true)) {
+                set_last_error(BRE_TFTF_LOAD_DATA);
+                return -1;
+            }
+            if (!hash_final_check(tftf.chunks->digests[tftf.next_chunk])) {
+                break;
+            }
+
+            dbgprintx32("Chunk ", tftf.next_chunk, " digest mismatch\n");
+            if (ops->rewind == NULL || retries-- == 0 ||
+                ops->rewind(blk_len)) {
+                set_last_error(BRE_TFTF_CHUNK_DIGEST);
+                return -1;
+            }
+        }
+
+        tftf.next_chunk++;
+        dest += blk_len;
+        len -= blk_len;
+    }
+
+    return 0;
+}
+
 /**
  * @brief Perform signature processing on a TFTF section
  *
@@ -263,16 +426,7 @@ static int process_tftf_section(data_load_ops *ops,
     }
 
     if (section->section_type == TFTF_SECTION_SIGNATURE) {
-        if (ops->load(&tftf.signature, sizeof(tftf.signature), false)) {
-            set_last_error(BRE_TFTF_LOAD_SIGNATURE);
-            return -1;
-        }
-        if (tftf.crypto_state == CRYPTO_STATE_HASHED) {
-            if (verify_signature(tftf.hash, &tftf.signature) == 0) {
-                tftf.crypto_state = CRYPTO_STATE_VERIFIED;
-            }
-        }
-        return 0;
+        return load_signature_section(ops, section);
     }
 
     dest = section->section_load_address;
@@ -282,11 +436,18 @@ static int process_tftf_section(data_load_ops *ops,
     }
 
     if (dest == DATA_ADDRESS_TO_BE_IGNORED) {
-        if (discard_section(ops, section, hash_loaded_data)) {
+        if (discard_section(ops, section->section_length, hash_loaded_data)) {
             set_last_error(BRE_TFTF_LOAD_DATA);
             return -1;
         }
     }
+    else if (tftf.chunks != NULL && is_section_hashed(section)) {
+        if (load_chunked_section(ops, CHIP_IMAGE_LOADING_DEST(dest),
+                                 section->section_length)) {
+            /* (load_chunked_section took care of error reporting) */
+            return -1;
+        }
+    }
     else if (ops->load(CHIP_IMAGE_LOADING_DEST(dest),
                        section->section_length,
                        hash_loaded_data)) {
@@ -294,6 +455,26 @@ static int process_tftf_section(data_load_ops *ops,
         return -1;
     }
 
+    if (section->section_type == TFTF_SECTION_CHUNK_DIGESTS) {
+        tftf.chunks = (tftf_chunk_digests *)CHIP_IMAGE_LOADING_DEST(dest);
+        if (tftf.chunks->chunk_size == 0 ||
+            tftf.chunks->num_chunks >
+            (section->section_length - sizeof(tftf_chunk_digests)) /
+            SHA256_HASH_DIGEST_SIZE) {
+            set_last_error(BRE_TFTF_CHUNK_TABLE);
+            return -1;
+        }
+
+        /*
+         * The signature covers the header and the table, and the table
+         * covers everything after it, so the image hash stops here
+         */
+        if (tftf.crypto_state == CRYPTO_STATE_HASHING) {
+            hash_final(tftf.hash);
+            tftf.crypto_state = CRYPTO_STATE_HASHED;
+        }
+    }
+
     return 0;
 }
 
@@ -323,6 +504,13 @@ int load_tftf_image(data_load_ops *ops, uint32_t *is_secure_image) {
         section++;
     }
 
+    if (tftf.chunks != NULL &&
+        tftf.next_chunk != tftf.chunks->num_chunks) {
+        /* the table describes a different image */
+        set_last_error(BRE_TFTF_CHUNK_TABLE);
+        return -1;
+    }
+
     if (tftf.crypto_state == CRYPTO_STATE_VERIFIED) {
         /* finished loading and verifying secured image */
         *is_secure_image = 1;
@@ -384,7 +572,7 @@ void jump_to_image(void) {
  */
 bool known_tftf_type(uint32_t section_type) {
      return (((section_type >= TFTF_SECTION_RAW_CODE) &&
-              (section_type <= TFTF_SECTION_MANIFEST)) ||
+              (section_type <= TFTF_SECTION_CHUNK_DIGESTS)) ||
              (section_type == TFTF_SECTION_SIGNATURE) ||
              (section_type == TFTF_SECTION_CERTIFICATE) ||
              (section_type == TFTF_SECTION_END));
@@ -10,8 +10,10 @@ DRFLAGS+= -D MCL_CURVE_B=MCL_CURVE_B_$(DREC)
 DRFLAGS+= -D MCL_CURVE_Order=MCL__CURVE_Order_$(DREC)
 DRFLAGS+= -D MCL_CURVE_Gx=MCL_CURVE_Gx_$(DREC)
 DRFLAGS+= -D MCL_CURVE_Gy=MCL_CURVE_Gy_$(DREC)
+DRFLAGS+= -D MCL_CURVE_GComb=MCL_CURVE_GComb_$(DREC)
 DRFLAGS+= -D MCL_rsa_public_key=MCL_rsa_public_key_$(DREC)
 DRFLAGS+= -D MCL_rsa_private_key=MCL_rsa_private_key_$(DREC)
+DRFLAGS+= -D MCL_ff_mont=MCL_ff_mont_$(DREC)
 DRFLAGS+= -D MCL_muladd=MCL_muladd_$(DREC)
 DRFLAGS+= -D MCL_BIG_iszilch=MCL_BIG_iszilch_$(DREC)
 DRFLAGS+= -D MCL_BIG_diszilch=MCL_BIG_diszilch_$(DREC)
@@ -78,6 +80,10 @@ DRFLAGS+= -D MCL_BIG_invmodp=MCL_BIG_invmodp_$(DREC)
 DRFLAGS+= -D MCL_CREATE_CSPRNG=MCL_CREATE_CSPRNG_$(DREC)
 DRFLAGS+= -D MCL_KILL_CSPRNG=MCL_KILL_CSPRNG_$(DREC)
 DRFLAGS+= -D MCL_HMAC=MCL_HMAC_$(DREC)
+DRFLAGS+= -D MCL_HMAC_init=MCL_HMAC_init_$(DREC)
+DRFLAGS+= -D MCL_HMAC_update=MCL_HMAC_update_$(DREC)
+DRFLAGS+= -D MCL_HMAC_final=MCL_HMAC_final_$(DREC)
+DRFLAGS+= -D MCL_HMAC_kill=MCL_HMAC_kill_$(DREC)
 DRFLAGS+= -D MCL_KDF2=MCL_KDF2_$(DREC)
 DRFLAGS+= -D MCL_PBKDF2=MCL_PBKDF2_$(DREC)
 DRFLAGS+= -D MCL_AES_CBC_IV0_ENCRYPT=MCL_AES_CBC_IV0_ENCRYPT_$(DREC)
@@ -85,6 +91,8 @@ DRFLAGS+= -D MCL_AES_CBC_IV0_DECRYPT=MCL_AES_CBC_IV0_DECRYPT_$(DREC)
 DRFLAGS+= -D MCL_ECP_KEY_PAIR_GENERATE=MCL_ECP_KEY_PAIR_GENERATE_$(DREC)
 DRFLAGS+= -D MCL_ECP_PUBLIC_KEY_VALIDATE=MCL_ECP_PUBLIC_KEY_VALIDATE_$(DREC)
 DRFLAGS+= -D MCL_ECPSVDP_DH=MCL_ECPSVDP_DH_$(DREC)
+DRFLAGS+= -D MCL_X25519=MCL_X25519_$(DREC)
+DRFLAGS+= -D MCL_X25519_KEY_PAIR_GENERATE=MCL_X25519_KEY_PAIR_GENERATE_$(DREC)
 DRFLAGS+= -D MCL_ECP_ECIES_ENCRYPT=MCL_ECP_ECIES_ENCRYPT_$(DREC)
 DRFLAGS+= -D MCL_ECP_ECIES_DECRYPT=MCL_ECP_ECIES_DECRYPT_$(DREC)
 DRFLAGS+= -D MCL_ECPSP_DSA=MCL_ECPSP_DSA_$(DREC)
@@ -111,7 +119,10 @@ DRFLAGS+= -D MCL_ECP_fromOctet=MCL_ECP_fromOctet_$(DREC)
 DRFLAGS+= -D MCL_ECP_dbl=MCL_ECP_dbl_$(DREC)
 DRFLAGS+= -D MCL_ECP_pinmul=MCL_ECP_pinmul_$(DREC)
 DRFLAGS+= -D MCL_ECP_mul=MCL_ECP_mul_$(DREC)
+DRFLAGS+= -D MCL_ECP_mul_gen=MCL_ECP_mul_gen_$(DREC)
+DRFLAGS+= -D MCL_ECP_gen_comb=MCL_ECP_gen_comb_$(DREC)
 DRFLAGS+= -D MCL_ECP_mul2=MCL_ECP_mul2_$(DREC)
+DRFLAGS+= -D MCL_ECP_mul2_vartime=MCL_ECP_mul2_vartime_$(DREC)
 DRFLAGS+= -D MCL_FF_copy=MCL_FF_copy_$(DREC)
 DRFLAGS+= -D MCL_FF_init=MCL_FF_init_$(DREC)
 DRFLAGS+= -D MCL_FF_zero=MCL_FF_zero_$(DREC)
@@ -140,6 +151,8 @@ DRFLAGS+= -D MCL_FF_randomnum=MCL_FF_randomnum_$(DREC)
 DRFLAGS+= -D MCL_FF_skpow=MCL_FF_skpow_$(DREC)
 DRFLAGS+= -D MCL_FF_skspow=MCL_FF_skspow_$(DREC)
 DRFLAGS+= -D MCL_FF_power=MCL_FF_power_$(DREC)
+DRFLAGS+= -D MCL_FF_mont_init=MCL_FF_mont_init_$(DREC)
+DRFLAGS+= -D MCL_FF_mont_power=MCL_FF_mont_power_$(DREC)
 DRFLAGS+= -D MCL_FF_pow=MCL_FF_pow_$(DREC)
 DRFLAGS+= -D MCL_FF_cfactor=MCL_FF_cfactor_$(DREC)
 DRFLAGS+= -D MCL_FF_prime=MCL_FF_prime_$(DREC)
@@ -170,5 +183,7 @@ DRFLAGS+= -D MCL_PKCS15=MCL_PKCS15_$(DRRSA)
 DRFLAGS+= -D MCL_OAEP_ENCODE=MCL_OAEP_ENCODE_$(DRRSA)
 DRFLAGS+= -D MCL_OAEP_DECODE=MCL_OAEP_DECODE_$(DRRSA)
 DRFLAGS+= -D MCL_RSA_ENCRYPT=MCL_RSA_ENCRYPT_$(DRRSA)
+DRFLAGS+= -D MCL_RSA_VERIFY_BATCH=MCL_RSA_VERIFY_BATCH_$(DRRSA)
+DRFLAGS+= -D MCL_RSA_VERIFY_BATCH_MT=MCL_RSA_VERIFY_BATCH_MT_$(DRRSA)
 DRFLAGS+= -D MCL_RSA_DECRYPT=MCL_RSA_DECRYPT_$(DRRSA)
 DRFLAGS+= -D MCL_RSA_PRIVATE_KEY_KILL=MCL_RSA_PRIVATE_KEY_KILL_$(DRRSA)
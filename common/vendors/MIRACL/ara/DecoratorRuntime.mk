@@ -2,9 +2,15 @@
 DRFLAGS:= -D MCL_CREATE_CSPRNG_DREC1=MCL_CREATE_CSPRNG_$(DREC1)
 DRFLAGS+= -D MCL_KDF2_DREC1=MCL_KDF2_$(DREC1)
 DRFLAGS+= -D MCL_PBKDF2_DREC1=MCL_PBKDF2_$(DREC1)
+DRFLAGS+= -D MCL_HMAC_init_DREC1=MCL_HMAC_init_$(DREC1)
+DRFLAGS+= -D MCL_HMAC_update_DREC1=MCL_HMAC_update_$(DREC1)
+DRFLAGS+= -D MCL_HMAC_final_DREC1=MCL_HMAC_final_$(DREC1)
+DRFLAGS+= -D MCL_HMAC_kill_DREC1=MCL_HMAC_kill_$(DREC1)
 DRFLAGS+= -D MCL_ECP_KEY_PAIR_GENERATE_DREC1=MCL_ECP_KEY_PAIR_GENERATE_$(DREC1)
 DRFLAGS+= -D MCL_ECP_PUBLIC_KEY_VALIDATE_DREC1=MCL_ECP_PUBLIC_KEY_VALIDATE_$(DREC1)
 DRFLAGS+= -D MCL_ECPSVDP_DH_DREC1=MCL_ECPSVDP_DH_$(DREC1)
+DRFLAGS+= -D MCL_X25519_DREC1=MCL_X25519_$(DREC1)
+DRFLAGS+= -D MCL_X25519_KEY_PAIR_GENERATE_DREC1=MCL_X25519_KEY_PAIR_GENERATE_$(DREC1)
 DRFLAGS+= -D MCL_ECP_ECIES_ENCRYPT_DREC1=MCL_ECP_ECIES_ENCRYPT_$(DREC1)
 DRFLAGS+= -D MCL_ECP_ECIES_DECRYPT_DREC1=MCL_ECP_ECIES_DECRYPT_$(DREC1)
 DRFLAGS+= -D MCL_ECPSP_DSA_DREC1=MCL_ECPSP_DSA_$(DREC1)
@@ -13,9 +19,15 @@ DRFLAGS+= -D MCL_KILL_CSPRNG_DREC1=MCL_KILL_CSPRNG_$(DREC1)
 DRFLAGS+= -D MCL_CREATE_CSPRNG_DREC2=MCL_CREATE_CSPRNG_$(DREC2)
 DRFLAGS+= -D MCL_KDF2_DREC2=MCL_KDF2_$(DREC2)
 DRFLAGS+= -D MCL_PBKDF2_DREC2=MCL_PBKDF2_$(DREC2)
+DRFLAGS+= -D MCL_HMAC_init_DREC2=MCL_HMAC_init_$(DREC2)
+DRFLAGS+= -D MCL_HMAC_update_DREC2=MCL_HMAC_update_$(DREC2)
+DRFLAGS+= -D MCL_HMAC_final_DREC2=MCL_HMAC_final_$(DREC2)
+DRFLAGS+= -D MCL_HMAC_kill_DREC2=MCL_HMAC_kill_$(DREC2)
 DRFLAGS+= -D MCL_ECP_KEY_PAIR_GENERATE_DREC2=MCL_ECP_KEY_PAIR_GENERATE_$(DREC2)
 DRFLAGS+= -D MCL_ECP_PUBLIC_KEY_VALIDATE_DREC2=MCL_ECP_PUBLIC_KEY_VALIDATE_$(DREC2)
 DRFLAGS+= -D MCL_ECPSVDP_DH_DREC2=MCL_ECPSVDP_DH_$(DREC2)
+DRFLAGS+= -D MCL_X25519_DREC2=MCL_X25519_$(DREC2)
+DRFLAGS+= -D MCL_X25519_KEY_PAIR_GENERATE_DREC2=MCL_X25519_KEY_PAIR_GENERATE_$(DREC2)
 DRFLAGS+= -D MCL_ECP_ECIES_ENCRYPT_DREC2=MCL_ECP_ECIES_ENCRYPT_$(DREC2)
 DRFLAGS+= -D MCL_ECP_ECIES_DECRYPT_DREC2=MCL_ECP_ECIES_DECRYPT_$(DREC2)
 DRFLAGS+= -D MCL_ECPSP_DSA_DREC2=MCL_ECPSP_DSA_$(DREC2)
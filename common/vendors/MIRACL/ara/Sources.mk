@@ -2,6 +2,7 @@
 LIBCORE_SRC := $(LIB_DIR)/mcl_aes.c
 LIBCORE_SRC += $(LIB_DIR)/mcl_gcm.c
 LIBCORE_SRC += $(LIB_DIR)/mcl_hash.c
+LIBCORE_SRC += $(LIB_DIR)/mcl_hash_x86.c
 LIBCORE_SRC += $(LIB_DIR)/mcl_oct.c
 LIBCORE_SRC += $(LIB_DIR)/mcl_rand.c
 LIBCORE_SRC += $(LIB_DIR)/mcl_x509.c
@@ -16,6 +17,8 @@ LIBCURVE_SRC += $(LIB_DIR)/mcl_fp.c
 STEST_SRC := $(TEST_DIR)/test_ecdh.c
 STEST_SRC += $(TEST_DIR)/test_rsa.c
 STEST_SRC += $(TEST_DIR)/test_hash.c
+STEST_SRC += $(TEST_DIR)/test_big.c
+STEST_SRC += $(TEST_DIR)/test_ecp.c
 
 # Unit tests
 TEST_SRC := $(TEST_DIR)/test_gcm_encrypt.c
@@ -32,6 +35,8 @@ endif
 # Benchmark tests
 BENCH_SRC := $(BENCH_DIR)/time_ecdh.c
 BENCH_SRC += $(BENCH_DIR)/time_rsa.c
+BENCH_SRC += $(BENCH_DIR)/time_rsa_batch.c
+BENCH_SRC += $(BENCH_DIR)/time_hash.c
 
 # Tests with three curves
 RTEST_SRC := $(TEST_DIR)/test_runtime.c
@@ -173,6 +173,11 @@ MCL_BS  - size of MCL_BIGs
 #endif
 #endif
 
+/* On 32-bit processors, define MCL_BIG_PACKED (CONFIG_BIG_PACKED=y in defconfig) for MCL_BIG_mul and
+   MCL_BIG_sqr to repack their inputs into full 32-bit words and multiply those with UMAAL or UMLAL,
+   rather than the reduced radix comba method */
+//#define MCL_BIG_PACKED
+
 /* For debugging Only. */
 //#define MCL_DEBUG_REDUCE 
 //#define MCL_DEBUG_NORM
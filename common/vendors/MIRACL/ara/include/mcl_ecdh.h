@@ -108,6 +108,38 @@ extern void MCL_HASH(int h,mcl_octet *I,mcl_octet *O);
 	@return 0 for bad parameters, else 1
  */
 extern int MCL_HMAC(int h,mcl_octet *M,mcl_octet *K,int len,mcl_octet *tag);
+/**	@brief Key an MCL_HMAC instance
+ *
+	Hashes the ipad and opad key blocks once and keeps the resulting states,
+	so the instance can then MAC any number of messages under key K.
+	@param H the MCL_HMAC instance
+	@param h is the hash type
+	@param K input key
+ */
+extern void MCL_HMAC_init(mcl_hmac *H,int h,mcl_octet *K);
+/**	@brief Add an array of bytes to the message being authenticated
+ *
+	May be called any number of times, so a message can be authenticated as it arrives.
+	@param H the MCL_HMAC instance
+	@param b the bytes to add
+	@param len the number of bytes
+ */
+extern void MCL_HMAC_update(mcl_hmac *H,const char *b,int len);
+/**	@brief Finish the current message and output its tag
+ *
+	The instance is left keyed and ready for the next message.
+	@param H the MCL_HMAC instance
+	@param len is output desired length of MCL_HMAC tag
+	@param tag is the output MCL_HMAC
+	@return 0 for bad parameters, else 1
+ */
+extern int MCL_HMAC_final(mcl_hmac *H,int len,mcl_octet *tag);
+/**	@brief Clear an MCL_HMAC instance
+ *
+	Deletes the cached key states
+	@param H the MCL_HMAC instance
+ */
+extern void MCL_HMAC_kill(mcl_hmac *H);
 
 /*extern void KDF1(mcl_octet *,int,mcl_octet *);*/
 
@@ -179,6 +211,30 @@ extern int  MCL_ECP_PUBLIC_KEY_VALIDATE(int f,mcl_octet *W);
  */
 extern int MCL_ECPSVDP_DH(mcl_octet *s,mcl_octet *W,mcl_octet *K);
 
+#if MCL_CHOICE==MCL_C25519
+/* RFC 7748 X25519 - x-only Montgomery ladder on Curve25519, whatever the curve form of this build */
+
+#define MCL_X25519_BYTES 32 /**< X25519 scalar and u-coordinate size in bytes */
+
+/**	@brief Generate an X25519 public/private key pair
+ *
+	@param R is a pointer to a cryptographically secure random number generator
+	@param s the private key, an output internally randomly generated if R!=NULL, otherwise must be provided as an input
+	@param W the output public key, which is X25519(s,9)
+	@return 0 or an error code
+ */
+extern int MCL_X25519_KEY_PAIR_GENERATE(csprng *R,mcl_octet *s,mcl_octet *W);
+/**	@brief Generate X25519 Diffie-Hellman shared key
+ *
+	RFC 7748 X25519 function, scalars and u-coordinates are 32-byte little-endian strings. Side-channel resistant.
+	@param s is the input private key
+	@param W the input public key (u-coordinate) of the other party
+	@param K the output shared key X25519(s,W)
+	@return 0, or MCL_ECDH_ERROR if the inputs are the wrong size or the shared key is all zero
+ */
+extern int MCL_X25519(mcl_octet *s,mcl_octet *W,mcl_octet *K);
+#endif
+
 /*#if MCL_CURVETYPE!=MCL_MONTGOMERY */
 /* ECIES functions */
 /**	@brief ECIES Encryption
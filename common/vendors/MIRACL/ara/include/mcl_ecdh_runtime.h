@@ -101,6 +101,10 @@ extern void MCL_CREATE_CSPRNG_DREC1(csprng *R,mcl_octet *S);
 extern void MCL_KILL_CSPRNG_DREC1(csprng *R);
 extern void MCL_HASH_DREC1(int h,mcl_octet *I,mcl_octet *O);
 extern int MCL_HMAC_DREC1(int h,mcl_octet *M,mcl_octet *K,int len,mcl_octet *tag);
+extern void MCL_HMAC_init_DREC1(mcl_hmac *H,int h,mcl_octet *K);
+extern void MCL_HMAC_update_DREC1(mcl_hmac *H,const char *b,int len);
+extern int MCL_HMAC_final_DREC1(mcl_hmac *H,int len,mcl_octet *tag);
+extern void MCL_HMAC_kill_DREC1(mcl_hmac *H);
 extern void MCL_KDF2_DREC1(int h,mcl_octet *Z,mcl_octet *P,int len,mcl_octet *K);
 extern void MCL_PBKDF2_DREC1(int h,mcl_octet *P,mcl_octet *S,int rep,int len,mcl_octet *K);
 extern void MCL_AES_CBC_IV0_ENCRYPT_DREC1(mcl_octet *K,mcl_octet *P,mcl_octet *C);
@@ -112,6 +116,10 @@ extern void MCL_ECP_ECIES_ENCRYPT_DREC1(int h,mcl_octet *P1,mcl_octet *P2,csprng
 extern int MCL_ECP_ECIES_DECRYPT_DREC1(int h,mcl_octet *P1,mcl_octet *P2,mcl_octet *V,mcl_octet *C,mcl_octet *T,mcl_octet *U,mcl_octet *M);
 extern int MCL_ECPSP_DSA_DREC1(int h,csprng *R,mcl_octet *s,mcl_octet *M,mcl_octet *c,mcl_octet *d);
 extern int MCL_ECPVP_DSA_DREC1(int h,mcl_octet *W,mcl_octet *M,mcl_octet *c,mcl_octet *d);
+#if MCL_CHOICE1==MCL_C25519
+extern int MCL_X25519_KEY_PAIR_GENERATE_DREC1(csprng *R,mcl_octet *s,mcl_octet *W);
+extern int MCL_X25519_DREC1(mcl_octet *s,mcl_octet *W,mcl_octet *K);
+#endif
 
 
 /******   Curve 2  *****/
@@ -146,6 +154,10 @@ extern void MCL_CREATE_CSPRNG_DREC2(csprng *R,mcl_octet *S);
 extern void MCL_KILL_CSPRNG_DREC2(csprng *R);
 extern void MCL_HASH_DREC2(int h,mcl_octet *I,mcl_octet *O);
 extern int MCL_HMAC_DREC2(int h,mcl_octet *M,mcl_octet *K,int len,mcl_octet *tag);
+extern void MCL_HMAC_init_DREC2(mcl_hmac *H,int h,mcl_octet *K);
+extern void MCL_HMAC_update_DREC2(mcl_hmac *H,const char *b,int len);
+extern int MCL_HMAC_final_DREC2(mcl_hmac *H,int len,mcl_octet *tag);
+extern void MCL_HMAC_kill_DREC2(mcl_hmac *H);
 extern void MCL_KDF2_DREC2(int h,mcl_octet *Z,mcl_octet *P,int len,mcl_octet *K);
 extern void MCL_PBKDF2_DREC2(int h,mcl_octet *P,mcl_octet *S,int rep,int len,mcl_octet *K);
 extern void MCL_AES_CBC_IV0_ENCRYPT_DREC2(mcl_octet *K,mcl_octet *P,mcl_octet *C);
@@ -157,6 +169,10 @@ extern void MCL_ECP_ECIES_ENCRYPT_DREC2(int h,mcl_octet *P1,mcl_octet *P2,csprng
 extern int MCL_ECP_ECIES_DECRYPT_DREC2(int h,mcl_octet *P1,mcl_octet *P2,mcl_octet *V,mcl_octet *C,mcl_octet *T,mcl_octet *U,mcl_octet *M);
 extern int MCL_ECPSP_DSA_DREC2(int h,csprng *R,mcl_octet *s,mcl_octet *M,mcl_octet *c,mcl_octet *d);
 extern int MCL_ECPVP_DSA_DREC2(int h,mcl_octet *W,mcl_octet *M,mcl_octet *c,mcl_octet *d);
+#if MCL_CHOICE2==MCL_C25519
+extern int MCL_X25519_KEY_PAIR_GENERATE_DREC2(csprng *R,mcl_octet *s,mcl_octet *W);
+extern int MCL_X25519_DREC2(mcl_octet *s,mcl_octet *W,mcl_octet *K);
+#endif
 
 
 #endif
@@ -68,6 +68,25 @@ extern const mcl_chunk MCL_CURVE_Order[]; /**< Elliptic curve group order */
 extern const mcl_chunk MCL_CURVE_Gx[]; /**< x-coordinate of generator point in group G1  */
 extern const mcl_chunk MCL_CURVE_Gy[]; /**< y-coordinate of generator point in group G1  */
 
+/* Fixed-base comb for the generator - see rom.c and MCL_ECP_mul_gen() */
+/* The signed scalar is split into MCL_COMB_TEETH rows of MCL_COMB_SPACING bits. Entry u of the table is the affine point
+   2^((TEETH-1)*SPACING).G + sum_{i<TEETH-1} (2*u_i-1).2^(i*SPACING).G, stored as x followed by y */
+#if MCL_CURVETYPE==MCL_EDWARDS && (MCL_CHUNK==32 || MCL_CHUNK==64)
+#if MCL_CHOICE==MCL_C25519
+#define MCL_COMB_ORDERBITS 253 /**< Number of bits in MCL_CURVE_Order */
+#endif
+#if MCL_CHOICE==MCL_C448
+#define MCL_COMB_ORDERBITS 446 /**< Number of bits in MCL_CURVE_Order */
+#endif
+#endif
+
+#ifdef MCL_COMB_ORDERBITS
+#define MCL_COMB_TEETH 5 /**< Number of comb teeth - the table in rom.c must be regenerated if this is changed */
+#define MCL_COMB_SPACING ((MCL_COMB_ORDERBITS+MCL_COMB_TEETH-1)/MCL_COMB_TEETH) /**< Distance in bits between teeth */
+#define MCL_COMB_POINTS (1<<(MCL_COMB_TEETH-1)) /**< Number of points in comb table */
+extern const mcl_chunk MCL_CURVE_GComb[]; /**< Comb table for generator point, MCL_COMB_POINTS affine points */
+#endif
+
 /**
 	@brief MCL_ECP structure - Elliptic Curve Point over base field
 */
@@ -242,6 +261,22 @@ extern void MCL_ECP_pinmul(MCL_ECP *P,int i,int b);
 
  */
 extern void MCL_ECP_mul(MCL_ECP *P,MCL_BIG b);
+/**	@brief Multiplies the curve generator by a MCL_BIG, side-channel resistant
+ *
+	Uses the fixed-base comb table held in ROM where one is provided for the curve, else falls back to MCL_ECP_mul().
+	The number of point operations does not depend on b.
+	@param P MCL_ECP instance, on exit =b*G
+	@param b MCL_BIG number multiplier, must be less than the group order
+ */
+extern void MCL_ECP_mul_gen(MCL_ECP *P,MCL_BIG b);
+#ifdef MCL_COMB_ORDERBITS
+/**	@brief Computes the fixed-base comb table for the curve generator
+ *
+	Used to generate MCL_CURVE_GComb in rom.c, and to check it.
+	@param T array of MCL_COMB_POINTS points, on exit the affine comb table
+ */
+extern void MCL_ECP_gen_comb(MCL_ECP T[]);
+#endif
 /**	@brief Calculates double multiplication P=e*P+f*Q, side-channel resistant
  *
 	@param P MCL_ECP instance, on exit =e*P+f*Q
@@ -250,5 +285,14 @@ extern void MCL_ECP_mul(MCL_ECP *P,MCL_BIG b);
 	@param f MCL_BIG number multiplier
  */
 extern void MCL_ECP_mul2(MCL_ECP *P,MCL_ECP *Q,MCL_BIG e,MCL_BIG f);
+/**	@brief Calculates double multiplication P=e*P+f*Q, using interleaved width-5 NAFs
+ *
+	Faster than MCL_ECP_mul2(), but NOT side-channel resistant - only for public multipliers, as in signature verification.
+	@param P MCL_ECP instance, on exit =e*P+f*Q
+	@param Q MCL_ECP instance
+	@param e MCL_BIG number multiplier
+	@param f MCL_BIG number multiplier
+ */
+extern void MCL_ECP_mul2_vartime(MCL_ECP *P,MCL_ECP *Q,MCL_BIG e,MCL_BIG f);
 
 #endif
@@ -61,8 +61,36 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
 
 #define MCL_HFLEN (MCL_FFLEN/2)
 
+/* Window size in bits for MCL_FF_skpow (fixed window) and MCL_FF_pow (sliding window).
+   MCL_FF_skpow keeps a table of 2^MCL_FF_WINDOW values and MCL_FF_pow one of
+   2^(MCL_FF_WINDOW-1), each of MCL_FFLEN MCL_BIGs on the stack, so every extra bit
+   doubles the workram for fewer multiplications. 0 selects the Montgomery ladder and
+   square-and-multiply.
+
+   The MCL_FF_skpow frame is 2^MCL_FF_WINDOW+2 FFs. For the stage 2 ERRK decryption
+   (MCL_C448, MCL_CHUNK 32, n=MCL_HFLEN=4, 272 bytes per FF) that is 816 bytes for 0,
+   1632 for 2, 2720 for 3 and 4896 for 4. The budget is 2K, which keeps MCL_RSA_DECRYPT
+   within the 8K stacks of the ARM test_rsa and time_rsa threads and leaves the stage 2
+   stack (down from the top of bufram3) to the loaders. Build with -DMCL_FF_WINDOW=n
+   where more stack is available */
+#ifndef MCL_FF_WINDOW
+#define MCL_FF_WINDOW 2
+#endif
+
 #include "mcl_oct.h"
 
+/**
+	@brief Montgomery constants of an FF modulus, worked out once and shared by many exponentiations
+*/
+
+typedef struct
+{
+    int n;     /**< size of the modulus in MCL_BIGs */
+    mcl_chunk p[MCL_FFLEN][MCL_BS];  /**< the modulus */
+    mcl_chunk ND[MCL_FFLEN][MCL_BS]; /**< Montgomery constant 1/p mod 2^(n.MCL_BIGBITS) */
+    mcl_chunk R2[MCL_FFLEN][MCL_BS]; /**< R^2 mod p, for conversion to n-residue form */
+} MCL_ff_mont;
+
 /* Finite Field Prototypes */
 /**	@brief Copy one FF element of given length to another
  *
@@ -248,6 +276,7 @@ extern void MCL_FF_random(mcl_chunk x[][MCL_BS],csprng *R,int n);
 extern void MCL_FF_randomnum(mcl_chunk x[][MCL_BS],mcl_chunk y[][MCL_BS],csprng *R,int n);
 /**	@brief Calculate r=x^e mod m, side channel resistant
  *
+	Fixed window of MCL_FF_WINDOW bits
 	@param r FF instance, on exit = x^e mod p
 	@param x FF instance
 	@param e FF exponent
@@ -275,8 +304,26 @@ extern void MCL_FF_skspow(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],MCL_BIG e,
 	@param n size of FF in MCL_BIGs
  */
 extern void MCL_FF_power(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],int e,mcl_chunk m[][MCL_BS],int n);
+/**	@brief Set up the Montgomery constants of a modulus for MCL_FF_mont_power
+ *
+	@param M the output Montgomery context
+	@param m FF modulus, must be odd
+	@param n size of FF in MCL_BIGs
+ */
+extern void MCL_FF_mont_init(MCL_ff_mont *M,mcl_chunk m[][MCL_BS],int n);
+/**	@brief Calculate r=x^e mod m, with the constants of m taken from a Montgomery context
+ *
+	As MCL_FF_power, for many exponentiations to the same modulus. M is only read,
+	so one context can be shared by concurrent callers
+	@param r FF instance, on exit = x^e mod m
+	@param x FF instance, must be less than m
+	@param e integer exponent
+	@param M Montgomery context of m, from MCL_FF_mont_init
+ */
+extern void MCL_FF_mont_power(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],int e,MCL_ff_mont *M);
 /**	@brief Calculate r=x^e mod m
  *
+	Sliding window of up to MCL_FF_WINDOW bits, not side channel resistant
 	@param r FF instance, on exit = x^e mod p
 	@param x FF instance
 	@param e FF exponent
@@ -62,6 +62,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
 #define MCL_SHA384 48 /**< SHA-384 hashing */
 #define MCL_SHA512 64 /**< SHA-512 hashing */
 
+#define MCL_HASH_SHANI 1 /**< x86 SHA extensions used for SHA-256 */
+#define MCL_HASH_AVX2 2  /**< AVX2 used for multi-buffer SHA-256 */
+
+/* The x86 code paths are only built into the host library */
+#if !defined(MCL_BUILD_ARM) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MCL_HASH_X86
+#endif
+
 /**
 	@brief SHA256/384/512 hash function instance
 */
@@ -83,6 +91,23 @@ int hlen;           /**< Hash length in bytes */
 typedef mcl_hash256 mcl_hash160;
 typedef mcl_hash512 mcl_hash384;
 
+/**
+	@brief Keyed HMAC instance
+
+	Caches the hash states left after the ipad and opad key blocks, so a key
+	is expanded once however many messages it authenticates.
+*/
+
+typedef struct {
+int sha;             /**< Hash type */
+mcl_hash256 s256;    /**< Running SHA1/SHA256 state */
+mcl_hash512 s512;    /**< Running SHA384/SHA512 state */
+unsign32 i256[8];    /**< SHA1/SHA256 state after the ipad block */
+unsign32 o256[8];    /**< SHA1/SHA256 state after the opad block */
+unsign64 i512[8];    /**< SHA384/SHA512 state after the ipad block */
+unsign64 o512[8];    /**< SHA384/SHA512 state after the opad block */
+} mcl_hmac;
+
 /* Hash function */
 /**	@brief Initialise an instance of SHA1
  *
@@ -95,6 +120,14 @@ extern void MCL_HASH160_init(mcl_hash160 *H);
 	@param b byte to be included in hash
  */
 extern void MCL_HASH160_process(mcl_hash160 *H,int b);
+/**	@brief Add an array of bytes to the hash
+ *
+	Whole 64-byte blocks are loaded straight into the transform
+	@param H an instance SHA1
+	@param b array of bytes to be included in hash
+	@param len number of bytes in b
+ */
+extern void MCL_HASH160_process_array(mcl_hash160 *H,const char *b,int len);
 /**	@brief Generate 20-byte hash
  *
 	@param H an instance SHA1
@@ -115,12 +148,44 @@ extern void MCL_HASH256_init(mcl_hash256 *H);
 	@param b byte to be included in hash
  */
 extern void MCL_HASH256_process(mcl_hash256 *H,int b);
+/**	@brief Add an array of bytes to the hash
+ *
+	Whole 64-byte blocks are loaded straight into the transform
+	@param H an instance SHA256
+	@param b array of bytes to be included in hash
+	@param len number of bytes in b
+ */
+extern void MCL_HASH256_process_array(mcl_hash256 *H,const char *b,int len);
 /**	@brief Generate 32-byte hash
  *
 	@param H an instance SHA256
 	@param h is the output 32-byte hash
  */
 extern void MCL_HASH256_hash(mcl_hash256 *H,char *h);
+/**	@brief Hash several independent messages with SHA256
+ *
+	Uses eight AVX2 lanes at a time when available, otherwise hashes
+	the messages one after the other
+	@param n number of messages
+	@param m array of n messages
+	@param len array of n message lengths in bytes
+	@param h is the output, n consecutive 32-byte hashes
+ */
+extern void MCL_HASH256_multi(int n,const char *m[],const int len[],char *h);
+
+/**	@brief Get the hardware hash support in use
+ *
+	The CPU is probed on first use
+	@return a mask of MCL_HASH_SHANI and MCL_HASH_AVX2, 0 for the portable code only
+ */
+extern int MCL_HASH_features(void);
+/**	@brief Restrict the hardware hash support in use
+ *
+	Features the CPU lacks are never enabled, so 0 forces the portable
+	code and -1 restores everything available
+	@param mask of MCL_HASH_SHANI and MCL_HASH_AVX2
+ */
+extern void MCL_HASH_set_features(int mask);
 
 
 /**	@brief Initialise an instance of SHA384
@@ -134,6 +199,14 @@ extern void MCL_HASH384_init(mcl_hash384 *H);
 	@param b byte to be included in hash
  */
 extern void MCL_HASH384_process(mcl_hash384 *H,int b);
+/**	@brief Add an array of bytes to the hash
+ *
+	Whole 128-byte blocks are loaded straight into the transform
+	@param H an instance SHA384
+	@param b array of bytes to be included in hash
+	@param len number of bytes in b
+ */
+extern void MCL_HASH384_process_array(mcl_hash384 *H,const char *b,int len);
 /**	@brief Generate 48-byte hash
  *
 	@param H an instance SHA384
@@ -153,6 +226,14 @@ extern void MCL_HASH512_init(mcl_hash512 *H);
 	@param b byte to be included in hash
  */
 extern void MCL_HASH512_process(mcl_hash512 *H,int b);
+/**	@brief Add an array of bytes to the hash
+ *
+	Whole 128-byte blocks are loaded straight into the transform
+	@param H an instance SHA512
+	@param b array of bytes to be included in hash
+	@param len number of bytes in b
+ */
+extern void MCL_HASH512_process_array(mcl_hash512 *H,const char *b,int len);
 /**	@brief Generate 64-byte hash
  *
 	@param H an instance SHA512
@@ -90,6 +90,12 @@ typedef struct
 
 
 #define MCL_RFS (MCL_MODBYTES*MCL_FFLEN) /**< RSA Public Key Size in bytes */
+
+/* Hosted Unix builds can spread a batch of signature verifications over POSIX threads */
+#if !defined(MCL_BUILD_ARM) && defined(__unix__)
+#define MCL_RSA_THREADS
+#define MCL_RSA_MAX_THREADS 64 /**< Most threads MCL_RSA_VERIFY_BATCH_MT will use */
+#endif
 #define MCL_HASH_TYPE_RSA MCL_SHA256 /**< Chosen Hash algorithm */
 
 
@@ -148,6 +154,32 @@ extern int  MCL_OAEP_DECODE(int h,mcl_octet *P,mcl_octet *F);
 	@param G is the output ciphertext
  */
 extern void MCL_RSA_ENCRYPT(MCL_rsa_public_key* PUB,mcl_octet *F,mcl_octet *G); 
+/**	@brief Verify a batch of RSA signatures made with one key
+ *
+	The Montgomery constants of the public modulus are worked out once for the whole batch
+	@param PUB the input RSA public key
+	@param S are the input signatures
+	@param W are the expected encodings of the signed messages, as from MCL_PKCS15
+	@param ok on exit ok[i]=1 if S[i] verifies against W[i], else 0
+	@param num the number of signatures
+	@return the number of signatures that verified
+ */
+extern int MCL_RSA_VERIFY_BATCH(MCL_rsa_public_key* PUB,mcl_octet *S[],mcl_octet *W[],int ok[],int num);
+#ifdef MCL_RSA_THREADS
+/**	@brief Verify a batch of RSA signatures made with one key, on several threads
+ *
+	As MCL_RSA_VERIFY_BATCH, with the signatures shared out between the calling thread
+	and threads-1 worker threads. Falls back to fewer threads if they cannot be created
+	@param PUB the input RSA public key
+	@param S are the input signatures
+	@param W are the expected encodings of the signed messages, as from MCL_PKCS15
+	@param ok on exit ok[i]=1 if S[i] verifies against W[i], else 0
+	@param num the number of signatures
+	@param threads the number of threads to verify on, at most MCL_RSA_MAX_THREADS
+	@return the number of signatures that verified
+ */
+extern int MCL_RSA_VERIFY_BATCH_MT(MCL_rsa_public_key* PUB,mcl_octet *S[],mcl_octet *W[],int ok[],int num,int threads);
+#endif
 /**	@brief RSA decryption of ciphertext
  *
 	@param PRIV the input RSA private key
@@ -71,6 +71,7 @@ static void test()
   mcl_octet CS={0,sizeof(cs),cs};
   mcl_octet DS={0,sizeof(ds),ds};
   csprng RNG;                
+  mcl_hmac H;
 
   /* fake random seed source */
   char* seedHex = "d50f4137faff934edfa309c110522f6f5c0ccb0d64e5bf4bf8ef79d1fe21031a";
@@ -113,6 +114,24 @@ static void test()
   MCL_OCT_output(&S0);
   printf("\r\n");
 
+  /* a PBKDF2 iteration is one 32-byte MAC; re-keying each time costs two extra blocks */
+  t1 = MCL_start_time();
+  for (i=0; i<1000*nIter; i++) {
+    MCL_HMAC(MCL_HASH_TYPE_ECC,&S0,&PW,32,&T);
+  }
+  totalTime = MCL_end_time(t1);
+  printf("MCL_HMAC one-shot: Iterations %d Total %d usecs Iteration %d nsecs \r\n", 1000*nIter, totalTime, totalTime/nIter);
+
+  MCL_HMAC_init(&H,MCL_HASH_TYPE_ECC,&PW);
+  t1 = MCL_start_time();
+  for (i=0; i<1000*nIter; i++) {
+    MCL_HMAC_update(&H,S0.val,S0.len);
+    MCL_HMAC_final(&H,32,&T);
+  }
+  totalTime = MCL_end_time(t1);
+  MCL_HMAC_kill(&H);
+  printf("MCL_HMAC keyed context: Iterations %d Total %d usecs Iteration %d nsecs \r\n", 1000*nIter, totalTime, totalTime/nIter);
+
   t1 = MCL_start_time();
   for (i=0; i<nIter; i++) {
     /* Generate Key pair S/W */
@@ -175,6 +194,24 @@ static void test()
     printf("*** MCL_ECPSVDP-DH Failed\r\n");
   }
 
+#if MCL_CHOICE==MCL_C25519
+  /* x-only Montgomery ladder against the generic path above */
+  {
+    char xs[MCL_X25519_BYTES],xw[MCL_X25519_BYTES],xk[MCL_X25519_BYTES];
+    mcl_octet XS={0,sizeof(xs),xs};
+    mcl_octet XW={0,sizeof(xw),xw};
+    mcl_octet XK={0,sizeof(xk),xk};
+
+    MCL_X25519_KEY_PAIR_GENERATE(&RNG,&XS,&XW);
+    t1 = MCL_start_time();
+    for (i=0; i<nIter; i++) {
+      MCL_X25519(&XS,&XW,&XK);
+    }
+    totalTime = MCL_end_time(t1);
+    printf("MCL_X25519: Iterations %d Total %d usecs Iteration %d usecs \r\n", nIter, totalTime, totalTime/nIter);
+  }
+#endif
+
   t1 = MCL_start_time();
   for (i=0; i<nIter; i++) {
     MCL_KDF2(MCL_HASH_TYPE_ECC,&Z0,NULL,MCL_EAS,&KEY);
@@ -262,6 +299,7 @@ static void test()
   }
   totalTime = MCL_end_time(t1);
   printf("MCL_ECPVP_DSA: Iterations %d Total %d usecs Iteration %d usecs \r\n", nIter, totalTime, totalTime/nIter);
+  printf("MCL_ECPVP_DSA: curve %d %d verifications/sec \r\n", MCL_CHOICE, (int)((double)nIter*1000000.0/totalTime));
 
   if (res !=0) {
     printf("***ECDSA Verification Failed\r\n");
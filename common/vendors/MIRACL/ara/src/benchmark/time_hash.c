@@ -0,0 +1,311 @@
+/*************************************************************************
+                                                                         *
+Copyright (c) 2015>, MIRACL Ltd                                          *
+All rights reserved.                                                     *
+                                                                         *
+This file is derived from the MIRACL for Ara SDK.                        *
+                                                                         *
+The MIRACL for Ara SDK provides developers with an                       *
+extensive and efficient set of cryptographic functions.                  *
+For further information about its features and functionalities           *
+please refer to https://www.miracl.com                                   *
+                                                                         *
+Redistribution and use in source and binary forms, with or without       *
+modification, are permitted provided that the following conditions are   *
+met:                                                                     *
+                                                                         *
+ 1. Redistributions of source code must retain the above copyright       *
+    notice, this list of conditions and the following disclaimer.        *
+                                                                         *
+ 2. Redistributions in binary form must reproduce the above copyright    *
+    notice, this list of conditions and the following disclaimer in the  *
+    documentation and/or other materials provided with the distribution. *
+                                                                         *
+ 3. Neither the name of the copyright holder nor the names of its        *
+    contributors may be used to endorse or promote products derived      *
+    from this software without specific prior written permission.        *
+                                                                         *
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS  *
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED    *
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A          *
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT       *
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,   *
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED *
+TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR   *
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF   *
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     *
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS       *
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
+                                                                         *
+**************************************************************************/
+
+
+
+/* Time Hash API Functions */
+
+ 
+#include "mcl_arch.h"
+#include "mcl_hash.h"
+#include "mcl_utils.h"
+
+const int nIter = ITERATIONS;
+
+/* size of the buffer hashed on each iteration */
+#define HASH_BUF_SIZE 16384
+
+static char buf[HASH_BUF_SIZE];
+
+/* hash buf one byte at a time, as the original process API requires */
+static void hash_bytewise(int sha,char *digest)
+{
+  int i;
+  mcl_hash256 sh256;
+  mcl_hash512 sh512;
+
+  switch (sha)
+  {
+  case MCL_SHA1:
+    MCL_HASH160_init(&sh256);
+    for (i=0;i<HASH_BUF_SIZE;i++) MCL_HASH160_process(&sh256,buf[i]);
+    MCL_HASH160_hash(&sh256,digest);
+    break;
+  case MCL_SHA256:
+    MCL_HASH256_init(&sh256);
+    for (i=0;i<HASH_BUF_SIZE;i++) MCL_HASH256_process(&sh256,buf[i]);
+    MCL_HASH256_hash(&sh256,digest);
+    break;
+  case MCL_SHA384:
+    MCL_HASH384_init(&sh512);
+    for (i=0;i<HASH_BUF_SIZE;i++) MCL_HASH384_process(&sh512,buf[i]);
+    MCL_HASH384_hash(&sh512,digest);
+    break;
+  case MCL_SHA512:
+    MCL_HASH512_init(&sh512);
+    for (i=0;i<HASH_BUF_SIZE;i++) MCL_HASH512_process(&sh512,buf[i]);
+    MCL_HASH512_hash(&sh512,digest);
+    break;
+  }
+}
+
+/* hash buf with a single call to the bulk process_array API */
+static void hash_bulk(int sha,char *digest)
+{
+  mcl_hash256 sh256;
+  mcl_hash512 sh512;
+
+  switch (sha)
+  {
+  case MCL_SHA1:
+    MCL_HASH160_init(&sh256);
+    MCL_HASH160_process_array(&sh256,buf,HASH_BUF_SIZE);
+    MCL_HASH160_hash(&sh256,digest);
+    break;
+  case MCL_SHA256:
+    MCL_HASH256_init(&sh256);
+    MCL_HASH256_process_array(&sh256,buf,HASH_BUF_SIZE);
+    MCL_HASH256_hash(&sh256,digest);
+    break;
+  case MCL_SHA384:
+    MCL_HASH384_init(&sh512);
+    MCL_HASH384_process_array(&sh512,buf,HASH_BUF_SIZE);
+    MCL_HASH384_hash(&sh512,digest);
+    break;
+  case MCL_SHA512:
+    MCL_HASH512_init(&sh512);
+    MCL_HASH512_process_array(&sh512,buf,HASH_BUF_SIZE);
+    MCL_HASH512_hash(&sh512,digest);
+    break;
+  }
+}
+
+static void time_hash(char *name,int sha)
+{
+  int i;
+  char d1[64],d2[64];
+
+#ifdef MCL_BUILD_ARM
+  unsigned int t1;
+#else
+  double t1;
+#endif			
+  unsigned int totalTime;
+
+  t1 = MCL_start_time();
+  for (i=0; i<nIter; i++)
+    hash_bytewise(sha,d1);
+  totalTime = MCL_end_time(t1);
+  printf("%s process: Iterations %d of %d bytes Total %d usecs Iteration %d usecs \r\n", name, nIter, HASH_BUF_SIZE, totalTime, totalTime/nIter);
+
+  t1 = MCL_start_time();
+  for (i=0; i<nIter; i++)
+    hash_bulk(sha,d2);
+  totalTime = MCL_end_time(t1);
+  printf("%s process_array: Iterations %d of %d bytes Total %d usecs Iteration %d usecs \r\n", name, nIter, HASH_BUF_SIZE, totalTime, totalTime/nIter);
+
+  if (memcmp(d1,d2,sha))
+    printf("ERROR %s digests differ\r\n", name);
+}
+
+/* Per block cost of the SHA384/512 transform. Build with and without
+   CONFIG_HASH512_SPLIT to compare the 32-bit register version */
+#if MCL_CHUNK==32 && defined(MCL_HASH512_SPLIT)
+#define SPLIT_NAME ", split"
+#else
+#define SPLIT_NAME ""
+#endif
+
+static void time_sha512_block()
+{
+  int i;
+  char d[64];
+  unsigned int blocks=nIter*(HASH_BUF_SIZE/128);
+
+#ifdef MCL_BUILD_ARM
+  unsigned int t1;
+#else
+  double t1;
+#endif			
+  unsigned int totalTime;
+
+  t1 = MCL_start_time();
+  for (i=0; i<nIter; i++)
+    hash_bulk(MCL_SHA512,d);
+  totalTime = MCL_end_time(t1);
+  printf("SHA512 transform (MCL_CHUNK %d%s): Blocks %d Total %d usecs Block %d nsecs \r\n", MCL_CHUNK, SPLIT_NAME, blocks, totalTime, (int)(1000.0*totalTime/blocks));
+}
+
+/* SHA256 on the portable code against the hardware code paths */
+static void time_sha256_paths()
+{
+  int i,k,features=MCL_HASH_features();
+  const char *m[8];
+  int len[8];
+  char d1[8*32],d2[8*32];
+  mcl_hash256 sh;
+
+#ifdef MCL_BUILD_ARM
+  unsigned int t1;
+#else
+  double t1;
+#endif			
+  unsigned int totalTime;
+
+  for (k=0;k<8;k++)
+  {
+    m[k]=buf;
+    len[k]=HASH_BUF_SIZE;
+  }
+
+  printf("Hardware hash features %d\r\n", features);
+
+  MCL_HASH_set_features(0);
+  t1 = MCL_start_time();
+  for (i=0; i<nIter; i++)
+    hash_bulk(MCL_SHA256,d1);
+  totalTime = MCL_end_time(t1);
+  printf("SHA256 portable: Iterations %d of %d bytes Total %d usecs Iteration %d usecs \r\n", nIter, HASH_BUF_SIZE, totalTime, totalTime/nIter);
+
+  t1 = MCL_start_time();
+  for (i=0; i<nIter; i++)
+    for (k=0;k<8;k++)
+    {
+      MCL_HASH256_init(&sh);
+      MCL_HASH256_process_array(&sh,m[k],len[k]);
+      MCL_HASH256_hash(&sh,&d1[32*k]);
+    }
+  totalTime = MCL_end_time(t1);
+  printf("SHA256 portable 8 messages: Iterations %d of 8x%d bytes Total %d usecs Iteration %d usecs \r\n", nIter, HASH_BUF_SIZE, totalTime, totalTime/nIter);
+
+  if (features&MCL_HASH_SHANI)
+  {
+    MCL_HASH_set_features(MCL_HASH_SHANI);
+    t1 = MCL_start_time();
+    for (i=0; i<nIter; i++)
+      hash_bulk(MCL_SHA256,d2);
+    totalTime = MCL_end_time(t1);
+    printf("SHA256 SHA-NI: Iterations %d of %d bytes Total %d usecs Iteration %d usecs \r\n", nIter, HASH_BUF_SIZE, totalTime, totalTime/nIter);
+    if (memcmp(d1,d2,32))
+      printf("ERROR SHA256 SHA-NI digest differs\r\n");
+
+    t1 = MCL_start_time();
+    for (i=0; i<nIter; i++)
+      MCL_HASH256_multi(8,m,len,d2);
+    totalTime = MCL_end_time(t1);
+    printf("SHA256 SHA-NI 8 messages: Iterations %d of 8x%d bytes Total %d usecs Iteration %d usecs \r\n", nIter, HASH_BUF_SIZE, totalTime, totalTime/nIter);
+  }
+
+  if (features&MCL_HASH_AVX2)
+  {
+    MCL_HASH_set_features(MCL_HASH_AVX2);
+    t1 = MCL_start_time();
+    for (i=0; i<nIter; i++)
+      MCL_HASH256_multi(8,m,len,d2);
+    totalTime = MCL_end_time(t1);
+    printf("SHA256 AVX2 8 messages: Iterations %d of 8x%d bytes Total %d usecs Iteration %d usecs \r\n", nIter, HASH_BUF_SIZE, totalTime, totalTime/nIter);
+    if (memcmp(d1,d2,8*32))
+      printf("ERROR SHA256 AVX2 digests differ\r\n");
+  }
+
+  MCL_HASH_set_features(-1);
+}
+
+static void test()
+{
+  int i;
+
+  for (i=0;i<HASH_BUF_SIZE;i++)
+    buf[i]=(char)i;
+
+  time_hash("SHA1",MCL_SHA1);
+  time_hash("SHA256",MCL_SHA256);
+  time_hash("SHA384",MCL_SHA384);
+  time_hash("SHA512",MCL_SHA512);
+  time_sha512_block();
+  time_sha256_paths();
+}
+#ifdef MCL_BUILD_ARM
+/* Thread handle */
+static os_thread_t test_thread;
+/* Buffer to be used as stack */
+static os_thread_stack_define(test_stack, 8 * 1024);
+
+/* create shadow yield thread */
+static int create_test_thread()
+{
+	int ret;
+	ret = os_thread_create(
+		/* thread handle */
+		&test_thread,
+		/* thread name */
+		"test",
+		/* entry function */
+		test,
+		/* argument */
+		0,
+		/* stack */
+		&test_stack,
+		/* priority */
+		OS_PRIO_3);
+	if (ret != WM_SUCCESS) {
+		wmprintf("Failed to create shadow yield thread: %d\r\n", ret);
+		return -WM_FAIL;
+	}
+	return WM_SUCCESS;
+}
+#endif
+
+int main()
+{   
+#ifdef MCL_BUILD_ARM
+  /* Initialize console on uart0 */
+  wmstdio_init(UART0_ID, 0);
+#endif
+
+#ifdef MCL_BUILD_ARM
+  create_test_thread();
+#else
+  test();
+#endif
+
+  return 0;
+}
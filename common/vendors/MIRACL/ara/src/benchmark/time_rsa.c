@@ -52,6 +52,8 @@ static void test()
 {
   int i;
   char m[MCL_RFS],ml[MCL_RFS],c[MCL_RFS],e[MCL_RFS],seed[32];
+  mcl_chunk p1[MCL_HFLEN][MCL_BS],q1[MCL_HFLEN][MCL_BS];
+  mcl_chunk l[MCL_FFLEN][MCL_BS],d[MCL_FFLEN][MCL_BS],g[MCL_FFLEN][MCL_BS];
 
   MCL_rsa_public_key pub;
   MCL_rsa_private_key priv;
@@ -77,6 +79,9 @@ static void test()
   /* initialise strong RNG */
   MCL_RSA_CREATE_CSPRNG(&RNG,&SEED);   
 
+  /* key generation and decryption times depend on it, build with -DMCL_FF_WINDOW=n to compare */
+  printf("MCL_FF_WINDOW %d bits\r\n", MCL_FF_WINDOW);
+
   printf("Generating public/private key pair\r\n");
   t1 = MCL_start_time();
   for (i=0; i<nIter; i++) {
@@ -119,6 +124,35 @@ static void test()
   printf("Plaintext= "); 
   MCL_OCT_output_string(&ML);
   printf("\r\n");
+
+  /* The same private key operation without CRT needs d = 1/e mod lcm(p-1,q-1).
+     p,q = 3 mod 4, so l = (p-1)/2.(q-1)/2 is odd and an odd inverse mod l will do */
+  MCL_FF_copy(p1,priv.p,MCL_HFLEN);
+  MCL_FF_dec(p1,1,MCL_HFLEN);
+  MCL_FF_shr(p1,MCL_HFLEN);
+  MCL_FF_copy(q1,priv.q,MCL_HFLEN);
+  MCL_FF_dec(q1,1,MCL_HFLEN);
+  MCL_FF_shr(q1,MCL_HFLEN);
+  MCL_FF_mul(l,p1,q1,MCL_HFLEN);
+  MCL_FF_init(d,pub.e,MCL_FFLEN);
+  MCL_FF_invmodp(d,d,l,MCL_FFLEN);
+  if (MCL_FF_parity(d)==0) MCL_FF_add(d,d,l,MCL_FFLEN);
+  MCL_FF_norm(d,MCL_FFLEN);
+
+  printf("Decrypting test string without CRT\r\n");
+  t1 = MCL_start_time();
+  for (i=0; i<nIter; i++) {
+    printf("Iter %d\r\n", i);
+    MCL_FF_fromOctet(g,&C,MCL_FFLEN);
+    MCL_FF_skpow(g,g,d,pub.n,MCL_FFLEN);
+  }
+  totalTime = MCL_end_time(t1);
+  printf("DECRYPTION NO CRT: Iterations %d Total %d usecs Iteration %d usecs \r\n", nIter, totalTime, totalTime/nIter);
+
+  MCL_FF_toOctet(&E,g,MCL_FFLEN);
+  MCL_RSA_DECRYPT(&priv,&C,&ML);
+  if (MCL_OCT_comp(&E,&ML)) printf("CRT and non-CRT decryption agree\r\n");
+  else printf("FAILURE CRT and non-CRT decryption differ\r\n");
 }
 
 #ifdef MCL_BUILD_ARM
@@ -0,0 +1,198 @@
+/*************************************************************************
+                                                                         *
+Copyright (c) 2015>, MIRACL Ltd                                          *
+All rights reserved.                                                     *
+                                                                         *
+This file is derived from the MIRACL for Ara SDK.                        *
+                                                                         *
+The MIRACL for Ara SDK provides developers with an                       *
+extensive and efficient set of cryptographic functions.                  *
+For further information about its features and functionalities           *
+please refer to https://www.miracl.com                                   *
+                                                                         *
+Redistribution and use in source and binary forms, with or without       *
+modification, are permitted provided that the following conditions are   *
+met:                                                                     *
+                                                                         *
+ 1. Redistributions of source code must retain the above copyright       *
+    notice, this list of conditions and the following disclaimer.        *
+                                                                         *
+ 2. Redistributions in binary form must reproduce the above copyright    *
+    notice, this list of conditions and the following disclaimer in the  *
+    documentation and/or other materials provided with the distribution. *
+                                                                         *
+ 3. Neither the name of the copyright holder nor the names of its        *
+    contributors may be used to endorse or promote products derived      *
+    from this software without specific prior written permission.        *
+                                                                         *
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS  *
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED    *
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A          *
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT       *
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,   *
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED *
+TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR   *
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF   *
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     *
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS       *
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
+                                                                         *
+**************************************************************************/
+
+
+/* Time batched RSA signature verification */
+
+ 
+#include "mcl_rsa.h"
+#include "mcl_utils.h"
+
+#define NSIGS 16   /* distinct signatures, each verified ITERATIONS times per batch */
+#define BATCH (NSIGS*ITERATIONS)
+
+static char sig[NSIGS][MCL_RFS],enc[NSIGS][MCL_RFS];
+static mcl_octet SIG[NSIGS],ENC[NSIGS];
+static mcl_octet *S[BATCH],*W[BATCH];
+static int ok[BATCH];
+
+static void report(const char *what,int good,unsigned int totalTime)
+{
+  printf("%s: Signatures %d Verified %d Total %d usecs %d signatures/sec\r\n",
+         what, BATCH, good, totalTime, (int)((double)BATCH*1000000.0/totalTime));
+}
+
+static void test()
+{
+  int i,good;
+  char m[MCL_RFS],seed[32];
+  char g[MCL_RFS];
+
+  MCL_rsa_public_key pub;
+  MCL_rsa_private_key priv;
+  csprng RNG;  
+  mcl_octet M={0,sizeof(m),m};
+  mcl_octet G={0,sizeof(g),g};
+  mcl_octet SEED={0,sizeof(seed),seed};
+
+  /* fake random seed source */
+  char* seedHex = "d50f4137faff934edfa309c110522f6f5c0ccb0d64e5bf4bf8ef79d1fe21031a";
+  MCL_hex2bin(seedHex, SEED.val, 64);
+  SEED.len=32;				
+
+#ifdef MCL_BUILD_ARM
+  unsigned int t1;
+#else
+  double t1;
+#endif			
+  unsigned int totalTime;
+
+  /* initialise strong RNG */
+  MCL_RSA_CREATE_CSPRNG(&RNG,&SEED);   
+
+  printf("Generating public/private key pair\r\n");
+  MCL_RSA_KEY_PAIR(&RNG,65537,&priv,&pub);
+
+  printf("Signing %d messages\r\n", NSIGS);
+  for (i=0; i<NSIGS; i++) {
+    SIG[i].len=0; SIG[i].max=MCL_RFS; SIG[i].val=sig[i];
+    ENC[i].len=0; ENC[i].max=MCL_RFS; ENC[i].val=enc[i];
+    MCL_OCT_clear(&M);
+    MCL_OCT_jstring(&M,(char *)"Hello World ");
+    MCL_OCT_jint(&M,i,4);
+    MCL_PKCS15(MCL_HASH_TYPE_RSA,&M,&ENC[i]);
+    MCL_RSA_DECRYPT(&priv,&ENC[i],&SIG[i]);
+  }
+  for (i=0; i<BATCH; i++) {
+    S[i]=&SIG[i%NSIGS];
+    W[i]=&ENC[i%NSIGS];
+  }
+
+  /* one MCL_RSA_ENCRYPT per signature works out the Montgomery constants every time */
+  good=0;
+  t1 = MCL_start_time();
+  for (i=0; i<BATCH; i++) {
+    MCL_RSA_ENCRYPT(&pub,S[i],&G);
+    good+=MCL_OCT_comp(&G,W[i]);
+  }
+  totalTime = MCL_end_time(t1);
+  report("MCL_RSA_ENCRYPT", good, totalTime);
+
+  t1 = MCL_start_time();
+  good=MCL_RSA_VERIFY_BATCH(&pub,S,W,ok,BATCH);
+  totalTime = MCL_end_time(t1);
+  report("MCL_RSA_VERIFY_BATCH", good, totalTime);
+
+#ifdef MCL_RSA_THREADS
+  {
+    int threads;
+    char what[64];
+    for (threads=1; threads<=8; threads*=2) {
+      t1 = MCL_start_time();
+      good=MCL_RSA_VERIFY_BATCH_MT(&pub,S,W,ok,BATCH,threads);
+      totalTime = MCL_end_time(t1);
+      sprintf(what, "MCL_RSA_VERIFY_BATCH_MT %d threads", threads);
+      report(what, good, totalTime);
+    }
+  }
+#endif
+
+  /* a batch with one message changed must fail that signature only */
+  W[BATCH/2]=&ENC[(BATCH/2+1)%NSIGS];
+#ifdef MCL_RSA_THREADS
+  good=MCL_RSA_VERIFY_BATCH_MT(&pub,S,W,ok,BATCH,4);
+#else
+  good=MCL_RSA_VERIFY_BATCH(&pub,S,W,ok,BATCH);
+#endif
+  if (good==BATCH-1 && !ok[BATCH/2]) printf("Batch rejects the mismatched signature\r\n");
+  else printf("FAILURE batch verified %d of %d signatures\r\n", good, BATCH);
+
+  MCL_RSA_KILL_CSPRNG(&RNG);
+
+  MCL_RSA_PRIVATE_KEY_KILL(&priv);
+}
+
+#ifdef MCL_BUILD_ARM
+/* Thread handle */
+static os_thread_t test_thread;
+/* Buffer to be used as stack */
+static os_thread_stack_define(test_stack, 16 * 1024);
+
+/* create shadow yield thread */
+static int create_test_thread()
+{
+	int ret;
+	ret = os_thread_create(
+		/* thread handle */
+		&test_thread,
+		/* thread name */
+		"test",
+		/* entry function */
+		test,
+		/* argument */
+		0,
+		/* stack */
+		&test_stack,
+		/* priority */
+		OS_PRIO_3);
+	if (ret != WM_SUCCESS) {
+		wmprintf("Failed to create shadow yield thread: %d\r\n", ret);
+		return -WM_FAIL;
+	}
+	return WM_SUCCESS;
+}
+#endif
+
+int main()
+{   
+#ifdef MCL_BUILD_ARM
+  /* Initialize console on uart0 */
+  wmstdio_init(UART0_ID, 0);
+#endif
+
+#ifdef MCL_BUILD_ARM
+  create_test_thread();
+#else
+  test();
+#endif
+
+  return 0;
+}
@@ -522,6 +522,134 @@ void MCL_BIG_pxmul(DMCL_BIG c,MCL_BIG a,int b)
 #endif
 }
 
+#if MCL_CHUNK==32 && defined(MCL_BIG_PACKED)
+
+/* Full radix products for 32-bit processors. A normalised MCL_BIG with a non-negative top
+   word is repacked into MCL_PLEN 32-bit words, least significant first, which are multiplied
+   without the excess bits of the reduced radix form, and the product unpacked to a DMCL_BIG */
+
+#define MCL_PLEN ((MCL_BASEBITS*(MCL_NLEN-1)+62)/32) /* the top word may use all 31 bits */
+
+/* hi:lo = x*y+lo+hi, which cannot overflow */
+#if defined(__ARM_ARCH_7EM__)
+#define MCL_UMAAL(lo,hi,x,y) __asm__ ("umaal %0, %1, %2, %3" : "+r" (lo), "+r" (hi) : "r" (x), "r" (y))
+#elif defined(__ARM_ARCH_7M__)
+/* UMAAL needs the DSP extension of ARMv7E-M, UMLAL and a carry will do */
+#define MCL_UMAAL(lo,hi,x,y) { unsign32 c_=(hi); (hi)=0; \
+	__asm__ ("umlal %0, %1, %3, %4\n\tadds %0, %0, %2\n\tadc %1, %1, #0" \
+	: "+&r" (lo), "+&r" (hi) : "r" (c_), "r" (x), "r" (y) : "cc"); }
+#else
+#define MCL_UMAAL(lo,hi,x,y) { unsign64 t_=(unsign64)(x)*(y)+(lo)+(hi); (lo)=(unsign32)t_; (hi)=(unsign32)(t_>>32); }
+#endif
+
+static void BIG_pack(unsign32 w[],MCL_BIG a)
+{
+	int i,j=0,n=0;
+	unsign64 t=0;
+	for (i=0;i<MCL_NLEN;i++)
+	{
+		t|=(unsign64)(unsign32)a[i]<<n;
+		n+=MCL_BASEBITS;
+		if (n>=32)
+		{
+			w[j++]=(unsign32)t;
+			t>>=32; n-=32;
+		}
+	}
+	while (j<MCL_PLEN)
+	{ /* rest of the top word */
+		w[j++]=(unsign32)t;
+		t>>=32;
+	}
+}
+
+static void BIG_dunpack(DMCL_BIG c,unsign32 w[])
+{
+	int i,j=0,n=0;
+	unsign64 t=0;
+	for (i=0;i<DMCL_NLEN-1;i++)
+	{
+		if (n<MCL_BASEBITS)
+		{
+			t|=(unsign64)w[j++]<<n;
+			n+=32;
+		}
+		c[i]=(mcl_chunk)t&BMASK;
+		t>>=MCL_BASEBITS; n-=MCL_BASEBITS;
+	}
+	if (j<2*MCL_PLEN) t|=(unsign64)w[j]<<n;
+	c[DMCL_NLEN-1]=(mcl_chunk)t;
+#ifdef MCL_DEBUG_NORM
+	c[DMCL_NLEN]=0;
+#endif
+}
+
+/* c=a*b, by rows */
+static void BIG_pmul(DMCL_BIG c,MCL_BIG a,MCL_BIG b)
+{
+	int i,j;
+	unsign32 x[MCL_PLEN],y[MCL_PLEN],z[2*MCL_PLEN];
+	unsign32 xi,lo,hi;
+
+	BIG_pack(x,a);
+	BIG_pack(y,b);
+	for (j=0;j<MCL_PLEN;j++) z[j]=0;
+
+	for (i=0;i<MCL_PLEN;i++)
+	{
+		xi=x[i]; hi=0;
+		for (j=0;j<MCL_PLEN;j++)
+		{
+			lo=z[i+j];
+			MCL_UMAAL(lo,hi,xi,y[j]);
+			z[i+j]=lo;
+		}
+		z[i+MCL_PLEN]=hi;
+	}
+	BIG_dunpack(c,z);
+}
+
+/* c=a*a, cross products once, doubled, then the squares added */
+static void BIG_psqr(DMCL_BIG c,MCL_BIG a)
+{
+	int i,j;
+	unsign32 x[MCL_PLEN],z[2*MCL_PLEN];
+	unsign32 xi,lo,hi;
+	unsign64 t;
+
+	BIG_pack(x,a);
+	for (j=0;j<2*MCL_PLEN;j++) z[j]=0;
+
+	for (i=0;i<MCL_PLEN-1;i++)
+	{
+		xi=x[i]; hi=0;
+		for (j=i+1;j<MCL_PLEN;j++)
+		{
+			lo=z[i+j];
+			MCL_UMAAL(lo,hi,xi,x[j]);
+			z[i+j]=lo;
+		}
+		z[i+MCL_PLEN]=hi;
+	}
+
+	for (j=2*MCL_PLEN-1;j>0;j--)
+		z[j]=(z[j]<<1)|(z[j-1]>>31);
+	z[0]<<=1;
+
+	hi=0;
+	for (i=0;i<MCL_PLEN;i++)
+	{
+		lo=z[2*i];
+		MCL_UMAAL(lo,hi,x[i],x[i]);
+		z[2*i]=lo;
+		t=(unsign64)z[2*i+1]+hi;
+		z[2*i+1]=(unsign32)t; hi=(unsign32)(t>>32);
+	}
+	BIG_dunpack(c,z);
+}
+
+#endif
+
 /* Set c=a*b */
 /* SU= 72 */
 void MCL_BIG_mul(DMCL_BIG c,MCL_BIG a,MCL_BIG b)
@@ -537,6 +665,14 @@ void MCL_BIG_mul(DMCL_BIG c,MCL_BIG a,MCL_BIG b)
 	MCL_BIG_norm(a);  /* needed here to prevent overflow from addition of partial products */
 	MCL_BIG_norm(b);
 
+#if MCL_CHUNK==32 && defined(MCL_BIG_PACKED)
+	if (a[MCL_NLEN-1]>=0 && b[MCL_NLEN-1]>=0)
+	{
+		BIG_pmul(c,a,b);
+		return;
+	}
+#endif
+
 /* Faster to Combafy it.. Let the compiler unroll the loops! */
 
 #ifdef MCL_COMBA
@@ -632,6 +768,14 @@ void MCL_BIG_sqr(DMCL_BIG c,MCL_BIG a)
 
 	MCL_BIG_norm(a);
 
+#if MCL_CHUNK==32 && defined(MCL_BIG_PACKED)
+	if (a[MCL_NLEN-1]>=0)
+	{
+		BIG_psqr(c,a);
+		return;
+	}
+#endif
+
 /* Note 2*a[i] in loop below and extra addition */
 
 #ifdef MCL_COMBA
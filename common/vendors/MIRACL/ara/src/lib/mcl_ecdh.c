@@ -46,103 +46,80 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
 
 #define ROUNDUP(a,b) ((a)-1)/(b)+1
 
-/* general purpose hash function w=hash(p|n|x|y) */
-static void hashit(int sha,mcl_octet *p,int n,mcl_octet *x,mcl_octet *y,mcl_octet *w)
+/* add an array of bytes to whichever hash is selected */
+static void hash_array(int sha,mcl_hash256 *sha256,mcl_hash512 *sha512,char *b,int len)
+{
+	switch(sha)
+	{
+	case MCL_SHA1:
+		MCL_HASH160_process_array(sha256,b,len); break;
+	case MCL_SHA256:
+		MCL_HASH256_process_array(sha256,b,len); break;
+	case MCL_SHA384:
+		MCL_HASH384_process_array(sha512,b,len); break;
+	case MCL_SHA512:
+		MCL_HASH512_process_array(sha512,b,len); break;
+	}
+}
+
+/* start whichever hash is selected */
+static void hash_init(int sha,mcl_hash256 *sha256,mcl_hash512 *sha512)
 {
-    int i,c[4],hlen;
-    mcl_hash256 sha256;
-	mcl_hash512 sha512;
-    char hh[64];
-	
 	switch (sha)
 	{
 	case MCL_SHA1 :
-		MCL_HASH160_init(&sha256); break;
+		MCL_HASH160_init(sha256); break;
 	case MCL_SHA256:
-		MCL_HASH256_init(&sha256); break;
+		MCL_HASH256_init(sha256); break;
 	case MCL_SHA384:
-		MCL_HASH384_init(&sha512); break;
+		MCL_HASH384_init(sha512); break;
 	case MCL_SHA512:
-		MCL_HASH512_init(&sha512); break;
+		MCL_HASH512_init(sha512); break;
 	}
-    
-	hlen=sha;
+}
 
-    if (p!=NULL) for (i=0;i<p->len;i++)
+/* finish whichever hash is selected, sha bytes to hh */
+static void hash_final(int sha,mcl_hash256 *sha256,mcl_hash512 *sha512,char *hh)
+{
+	switch (sha)
 	{
-		switch(sha)
-		{
-		case MCL_SHA1:
-			MCL_HASH160_process(&sha256,p->val[i]); break;
-		case MCL_SHA256:
-			MCL_HASH256_process(&sha256,p->val[i]); break;
-		case MCL_SHA384:
-			MCL_HASH384_process(&sha512,p->val[i]); break;
-		case MCL_SHA512:
-			MCL_HASH512_process(&sha512,p->val[i]); break;
-		}
+	case MCL_SHA1:
+		MCL_HASH160_hash(sha256,hh); break;
+	case MCL_SHA256:
+		MCL_HASH256_hash(sha256,hh); break;
+	case MCL_SHA384:
+		MCL_HASH384_hash(sha512,hh); break;
+	case MCL_SHA512:
+		MCL_HASH512_hash(sha512,hh); break;
 	}
+}
+
+/* general purpose hash function w=hash(p|n|x|y) */
+static void hashit(int sha,mcl_octet *p,int n,mcl_octet *x,mcl_octet *y,mcl_octet *w)
+{
+    int i,hlen;
+    char c[4];
+    mcl_hash256 sha256;
+	mcl_hash512 sha512;
+    char hh[64];
+	
+	hash_init(sha,&sha256,&sha512);
+    
+	hlen=sha;
+
+    if (p!=NULL) hash_array(sha,&sha256,&sha512,p->val,p->len);
 	if (n>0)
     {
         c[0]=(n>>24)&0xff;
         c[1]=(n>>16)&0xff;
         c[2]=(n>>8)&0xff;
         c[3]=(n)&0xff;
-		for (i=0;i<4;i++)
-		{
-			switch(sha)
-			{
-			case MCL_SHA1:
-				MCL_HASH160_process(&sha256,c[i]); break;
-			case MCL_SHA256:
-				MCL_HASH256_process(&sha256,c[i]); break;
-			case MCL_SHA384:
-				MCL_HASH384_process(&sha512,c[i]); break;
-			case MCL_SHA512:
-				MCL_HASH512_process(&sha512,c[i]); break;
-			}
-		}
+		hash_array(sha,&sha256,&sha512,c,4);
     }
-    if (x!=NULL) for (i=0;i<x->len;i++)
-	{
-		switch(sha)
-		{
-		case MCL_SHA1:
-			MCL_HASH160_process(&sha256,x->val[i]); break;
-		case MCL_SHA256:
-			MCL_HASH256_process(&sha256,x->val[i]); break;
-		case MCL_SHA384:
-			MCL_HASH384_process(&sha512,x->val[i]); break;
-		case MCL_SHA512:
-			MCL_HASH512_process(&sha512,x->val[i]); break;
-		}
-	}
-    if (y!=NULL) for (i=0;i<y->len;i++)
-	{
-		switch(sha)
-		{
-		case MCL_SHA1:
-			MCL_HASH160_process(&sha256,y->val[i]); break;
-		case MCL_SHA256:
-			MCL_HASH256_process(&sha256,y->val[i]); break;
-		case MCL_SHA384:
-			MCL_HASH384_process(&sha512,y->val[i]); break;
-		case MCL_SHA512:
-			MCL_HASH512_process(&sha512,y->val[i]); break;
-		}
-	}
+    if (x!=NULL) hash_array(sha,&sha256,&sha512,x->val,x->len);
+    if (y!=NULL) hash_array(sha,&sha256,&sha512,y->val,y->len);
 	
-	switch (sha)
-	{
-	case MCL_SHA1:
-		MCL_HASH160_hash(&sha256,hh); break;
-	case MCL_SHA256:
-		MCL_HASH256_hash(&sha256,hh); break;
-	case MCL_SHA384:
-		MCL_HASH384_hash(&sha512,hh); break;
-	case MCL_SHA512:
-		MCL_HASH512_hash(&sha512,hh); break;
-	}
+	hash_final(sha,&sha256,&sha512,hh);
 
     MCL_OCT_empty(w);
     MCL_OCT_jbytes(w,hh,hlen);
@@ -174,33 +151,103 @@ int MCL_HMAC(int sha,mcl_octet *m,mcl_octet *k,int olen,mcl_octet *tag)
 /* Input is from an mcl_octet m        *
  * olen is requested output length in bytes. k is the key  *
  * The output is the calculated tag */
-    int hlen,b;
-	char h[64],k0[128];
-    mcl_octet H={0,sizeof(h),h};
-	mcl_octet K0={0,sizeof(k0),k0};
-
-    hlen=sha; b=64;
-	if (hlen>32) b=128;
+	mcl_hmac H;
+	int res;
 
     if (olen<4 /*|| olen>hlen+2*/) return 0;  
 
+	MCL_HMAC_init(&H,sha,k);
+	MCL_HMAC_update(&H,m->val,m->len);
+	res=MCL_HMAC_final(&H,olen,tag);
+	MCL_HMAC_kill(&H);
+	return res;
+}
+
+/* restart the running hash from a cached key state. The cached states sit on a
+   block boundary, so only the chaining value and length need putting back -
+   partial words left in w[] are shifted out as new bytes arrive */
+static void hmac_restore(mcl_hmac *H,unsign32 *s256,unsign64 *s512)
+{
+	int i;
+	if (H->sha>32)
+	{
+		for (i=0;i<8;i++) H->s512.h[i]=s512[i];
+		H->s512.length[0]=1024; H->s512.length[1]=0;
+	}
+	else
+	{
+		for (i=0;i<8;i++) H->s256.h[i]=s256[i];
+		H->s256.length[0]=512; H->s256.length[1]=0;
+	}
+}
+
+/* hash one padded key block and keep the state it leaves */
+static void hmac_key_block(mcl_hmac *H,char *k0,int b,unsign32 *s256,unsign64 *s512)
+{
+	int i;
+	hash_init(H->sha,&H->s256,&H->s512);
+	hash_array(H->sha,&H->s256,&H->s512,k0,b);
+	if (H->sha>32) for (i=0;i<8;i++) s512[i]=H->s512.h[i];
+	else           for (i=0;i<8;i++) s256[i]=H->s256.h[i];
+}
+
+/* Key an MCL_HMAC instance - the padded key blocks are hashed here, once */
+void MCL_HMAC_init(mcl_hmac *H,int sha,mcl_octet *k)
+{
+	int b;
+	char k0[128];
+	mcl_octet K0={0,sizeof(k0),k0};
+
+	H->sha=sha; b=64;
+	if (sha>32) b=128;
+
     if (k->len > b) hashit(sha,k,-1,NULL,NULL,&K0);
     else            MCL_OCT_copy(&K0,k);
 
     MCL_OCT_jbyte(&K0,0,b-K0.len);
 
     MCL_OCT_xorbyte(&K0,0x36);
-
-    hashit(sha,&K0,-1,m,NULL,&H);
+	hmac_key_block(H,K0.val,b,H->i256,H->i512);
 
     MCL_OCT_xorbyte(&K0,0x6a);   /* 0x6a = 0x36 ^ 0x5c */
-    hashit(sha,&K0,-1,&H,NULL,&H);
+	hmac_key_block(H,K0.val,b,H->o256,H->o512);
+
+	MCL_OCT_clear(&K0);
+	hmac_restore(H,H->i256,H->i512);
+}
+
+/* Add bytes to the message being authenticated */
+void MCL_HMAC_update(mcl_hmac *H,const char *b,int len)
+{
+	hash_array(H->sha,&H->s256,&H->s512,(char *)b,len);
+}
+
+/* Finish the message, output the tag and rewind to the inner key state */
+int MCL_HMAC_final(mcl_hmac *H,int olen,mcl_octet *tag)
+{
+	char h[64];
+
+    if (olen<4) return 0;
+
+	hash_final(H->sha,&H->s256,&H->s512,h);
+	hmac_restore(H,H->o256,H->o512);
+	hash_array(H->sha,&H->s256,&H->s512,h,H->sha);
+	hash_final(H->sha,&H->s256,&H->s512,h);
+	hmac_restore(H,H->i256,H->i512);
+
     MCL_OCT_empty(tag);
+	if (olen>H->sha) olen=H->sha;
+    MCL_OCT_jbytes(tag,h,olen);
 
-	if (olen>sha) olen=sha;
-    MCL_OCT_jbytes(tag,H.val,olen);
+	return 1;
+}
 
-    return 1;
+/* Delete the cached key states */
+void MCL_HMAC_kill(mcl_hmac *H)
+{
+	int i;
+	char *p=(char *)H;
+	for (i=0;i<(int)sizeof(mcl_hmac);i++) p[i]=0;
 }
 
 /* Key Derivation Functions */
@@ -251,27 +298,36 @@ void MCL_KDF2(int sha,mcl_octet *z,mcl_octet *p,int olen,mcl_octet *key)
 /* Output key of length olen */
 void MCL_PBKDF2(int sha,mcl_octet *p,mcl_octet *s,int rep,int olen,mcl_octet *key)
 {
-	int i,j,len,d=ROUNDUP(olen,sha);
-	char f[MCL_EFS],u[MCL_EFS];
+	int i,j,d=ROUNDUP(olen,sha);
+	char f[MCL_EFS],u[MCL_EFS],c[4];
 	mcl_octet F={0,sizeof(f),f};
 	mcl_octet U={0,sizeof(u),u};
+	mcl_hmac H;
+
+	/* the password is the key for every iteration, so expand it once */
+	MCL_HMAC_init(&H,sha,p);
 	MCL_OCT_empty(key);
 	for (i=1;i<=d;i++)
 	{
-		len=s->len;
-		MCL_OCT_jint(s,i,4);
-		MCL_HMAC(sha,s,p,MCL_EFS,&F);
+		c[0]=(i>>24)&0xff;
+		c[1]=(i>>16)&0xff;
+		c[2]=(i>>8)&0xff;
+		c[3]=(i)&0xff;
+		MCL_HMAC_update(&H,s->val,s->len);
+		MCL_HMAC_update(&H,c,4);
+		MCL_HMAC_final(&H,MCL_EFS,&F);
 
-		s->len=len;
 		MCL_OCT_copy(&U,&F);
 		for (j=2;j<=rep;j++)
 		{
-			MCL_HMAC(sha,&U,p,MCL_EFS,&U);
+			MCL_HMAC_update(&H,U.val,U.len);
+			MCL_HMAC_final(&H,MCL_EFS,&U);
 			MCL_OCT_xor(&F,&U);
 		}
 
 		MCL_OCT_jmcl_octet(key,&F);
 	}
+	MCL_HMAC_kill(&H);
 	MCL_OCT_chop(key,NULL,olen);
 }
 
@@ -371,13 +427,6 @@ int MCL_ECP_KEY_PAIR_GENERATE(csprng *RNG,mcl_octet* S,mcl_octet *W)
     mcl_chunk r[MCL_BS],gx[MCL_BS],gy[MCL_BS],s[MCL_BS];
     MCL_ECP G;
     int res=0;
-	MCL_BIG_rcopy(gx,MCL_CURVE_Gx);
-#if MCL_CURVETYPE!=MCL_MONTGOMERY
-	MCL_BIG_rcopy(gy,MCL_CURVE_Gy);
-    MCL_ECP_set(&G,gx,gy);
-#else
-    MCL_ECP_set(&G,gx);
-#endif
 
 	MCL_BIG_rcopy(r,MCL_CURVE_Order);
     if (RNG!=NULL)
@@ -388,7 +437,7 @@ int MCL_ECP_KEY_PAIR_GENERATE(csprng *RNG,mcl_octet* S,mcl_octet *W)
 		MCL_BIG_mod(s,r);
 	}
 
-    MCL_ECP_mul(&G,s);
+    MCL_ECP_mul_gen(&G,s);
 #if MCL_CURVETYPE!=MCL_MONTGOMERY
     MCL_ECP_get(gx,gy,&G);
 #else
@@ -486,6 +535,128 @@ int MCL_ECPSVDP_DH(mcl_octet *S,mcl_octet *WD,mcl_octet *Z)
     return res;
 }
 
+#if MCL_CHOICE==MCL_C25519
+
+/* r=z^(p-2)=1/z, fixed addition chain for p=2^255-19 */
+static void x25519_inv(MCL_BIG r,MCL_BIG z)
+{
+	int i;
+	mcl_chunk z2[MCL_BS],z11[MCL_BS],a[MCL_BS],b[MCL_BS],t[MCL_BS];
+
+	MCL_FP_sqr(z2,z);
+	MCL_FP_sqr(t,z2); MCL_FP_sqr(t,t);
+	MCL_FP_mul(b,t,z);                          /* z^9 */
+	MCL_FP_mul(z11,b,z2);                       /* z^11 */
+	MCL_FP_sqr(t,z11);
+	MCL_FP_mul(b,t,b);                          /* z^(2^5-1) */
+	MCL_FP_sqr(t,b);   for (i=1;i<5;i++) MCL_FP_sqr(t,t);
+	MCL_FP_mul(b,t,b);                          /* z^(2^10-1) */
+	MCL_FP_sqr(t,b);   for (i=1;i<10;i++) MCL_FP_sqr(t,t);
+	MCL_FP_mul(a,t,b);                          /* z^(2^20-1) */
+	MCL_FP_sqr(t,a);   for (i=1;i<20;i++) MCL_FP_sqr(t,t);
+	MCL_FP_mul(t,t,a);                          /* z^(2^40-1) */
+	for (i=0;i<10;i++) MCL_FP_sqr(t,t);
+	MCL_FP_mul(b,t,b);                          /* z^(2^50-1) */
+	MCL_FP_sqr(t,b);   for (i=1;i<50;i++) MCL_FP_sqr(t,t);
+	MCL_FP_mul(a,t,b);                          /* z^(2^100-1) */
+	MCL_FP_sqr(t,a);   for (i=1;i<100;i++) MCL_FP_sqr(t,t);
+	MCL_FP_mul(t,t,a);                          /* z^(2^200-1) */
+	for (i=0;i<50;i++) MCL_FP_sqr(t,t);
+	MCL_FP_mul(t,t,b);                          /* z^(2^250-1) */
+	for (i=0;i<5;i++) MCL_FP_sqr(t,t);
+	MCL_FP_mul(r,t,z11);                        /* z^(2^255-21) */
+}
+
+/* RFC 7748 Montgomery ladder, r=X25519(k,u) for clamped little-endian k */
+static void x25519_ladder(MCL_BIG r,char *k,MCL_BIG u)
+{
+	int t,b,swap=0;
+	mcl_chunk x2[MCL_BS],z2[MCL_BS],x3[MCL_BS],z3[MCL_BS];
+	mcl_chunk A[MCL_BS],AA[MCL_BS],B[MCL_BS],BB[MCL_BS],C[MCL_BS],D[MCL_BS],E[MCL_BS],a24[MCL_BS];
+
+/* (A+2)/4 for A=486662, as a field element - MCL_FP_imul by a constant this large takes the slow double-length path */
+	MCL_BIG_zero(a24); MCL_BIG_inc(a24,121666); MCL_FP_nres(a24);
+	MCL_FP_one(x2); MCL_BIG_zero(z2);
+	MCL_BIG_copy(x3,u); MCL_FP_one(z3);
+
+	for (t=254;t>=0;t--)
+	{
+		b=(((unsigned char)k[t/8])>>(t%8))&1;
+		swap^=b;
+		MCL_BIG_cswap(x2,x3,swap);
+		MCL_BIG_cswap(z2,z3,swap);
+		swap=b;
+
+		MCL_FP_add(A,x2,z2); MCL_FP_sqr(AA,A);
+		MCL_FP_sub(B,x2,z2); MCL_FP_sqr(BB,B);
+		MCL_FP_sub(E,AA,BB);
+		MCL_FP_add(C,x3,z3);
+		MCL_FP_sub(D,x3,z3);
+		MCL_FP_mul(D,D,A);     /* DA */
+		MCL_FP_mul(C,C,B);     /* CB */
+
+		MCL_FP_add(x3,D,C); MCL_FP_sqr(x3,x3);
+		MCL_FP_sub(z3,D,C); MCL_FP_sqr(z3,z3);
+		MCL_FP_mul(z3,z3,u);
+		MCL_FP_mul(x2,AA,BB);
+		MCL_FP_mul(A,E,a24);
+		MCL_FP_add(A,A,BB);
+		MCL_FP_mul(z2,A,E);
+
+		MCL_BIG_norm(x2); MCL_BIG_norm(z2);
+		MCL_BIG_norm(x3); MCL_BIG_norm(z3);
+	}
+	MCL_BIG_cswap(x2,x3,swap);
+	MCL_BIG_cswap(z2,z3,swap);
+
+	x25519_inv(z2,z2);
+	MCL_FP_mul(r,x2,z2);
+	MCL_FP_redc(r);
+	MCL_FP_reduce(r);
+}
+
+/* RFC 7748 X25519 Diffie-Hellman K=X25519(S,W) */
+int MCL_X25519(mcl_octet *S,mcl_octet *W,mcl_octet *K)
+{
+	int i,res=0;
+	char k[MCL_X25519_BYTES],b[MCL_X25519_BYTES];
+	mcl_chunk u[MCL_BS],r[MCL_BS];
+
+	if (S->len!=MCL_X25519_BYTES || W->len!=MCL_X25519_BYTES) return MCL_ECDH_ERROR;
+
+	for (i=0;i<MCL_X25519_BYTES;i++) k[i]=S->val[i];
+	k[0]&=248; k[31]&=127; k[31]|=64;
+
+/* u is little-endian, top bit ignored */
+	for (i=0;i<MCL_X25519_BYTES;i++) b[i]=W->val[MCL_X25519_BYTES-1-i];
+	b[0]&=127;
+	MCL_BIG_fromBytes(u,b);
+	MCL_FP_nres(u);
+
+	x25519_ladder(r,k,u);
+	if (MCL_BIG_iszilch(r)) res=MCL_ECDH_ERROR;
+
+	MCL_BIG_toBytes(b,r);
+	for (i=0;i<MCL_X25519_BYTES;i++) K->val[i]=b[MCL_X25519_BYTES-1-i];
+	K->len=MCL_X25519_BYTES;
+
+	for (i=0;i<MCL_X25519_BYTES;i++) k[i]=0;
+	return res;
+}
+
+/* X25519 key pair, W=X25519(S,9) */
+int MCL_X25519_KEY_PAIR_GENERATE(csprng *RNG,mcl_octet *S,mcl_octet *W)
+{
+	char nine[MCL_X25519_BYTES]={9};
+	mcl_octet U={MCL_X25519_BYTES,sizeof(nine),nine};
+
+	if (RNG!=NULL)
+		MCL_OCT_rand(S,RNG,MCL_X25519_BYTES);
+	return MCL_X25519(S,&U,W);
+}
+
+#endif
+
 #if MCL_CURVETYPE!=MCL_MONTGOMERY
 
 /* IEEE ECDSA Signature, C and D are signature on F using private key S */
@@ -494,25 +665,21 @@ int MCL_ECPSP_DSA(int sha,csprng *RNG,mcl_octet *S,mcl_octet *F,mcl_octet *C,mcl
 	char h[66];  // +2 is patch for MCL_NIST521
 	mcl_octet H={0,sizeof(h),h};
 
-    mcl_chunk gx[MCL_BS],gy[MCL_BS],r[MCL_BS],s[MCL_BS],f[MCL_BS],c[MCL_BS],d[MCL_BS],u[MCL_BS],vx[MCL_BS];
-    MCL_ECP G,V;
+    mcl_chunk r[MCL_BS],s[MCL_BS],f[MCL_BS],c[MCL_BS],d[MCL_BS],u[MCL_BS],vx[MCL_BS];
+    MCL_ECP V;
 
 	hashit(sha,F,-1,NULL,NULL,&H); 
 
-	MCL_BIG_rcopy(gx,MCL_CURVE_Gx);
-	MCL_BIG_rcopy(gy,MCL_CURVE_Gy);
 	MCL_BIG_rcopy(r,MCL_CURVE_Order);
 	
 	MCL_BIG_fromBytes(s,S->val);
 	if (MCL_MODBYTES>sha) MCL_OCT_shr(&H,MCL_MODBYTES-sha); // patch for MCL_NIST521
 
 	MCL_BIG_fromBytesLen(f,H.val,H.len);
-    MCL_ECP_set(&G,gx,gy);
 
     do {
 		MCL_BIG_randomnum(u,r,RNG);
-        MCL_ECP_copy(&V,&G);
-        MCL_ECP_mul(&V,u);   
+        MCL_ECP_mul_gen(&V,u);   
 		
         MCL_ECP_get(vx,vx,&V);
 
@@ -582,7 +749,7 @@ int MCL_ECPVP_DSA(int sha,mcl_octet *W,mcl_octet *F, mcl_octet *C,mcl_octet *D)
         if (!valid) res=MCL_ECDH_ERROR;
         else
         {
-			MCL_ECP_mul2(&WP,&G,h2,f);
+			MCL_ECP_mul2_vartime(&WP,&G,h2,f);
 
             if (MCL_ECP_isinf(&WP)) res=MCL_ECDH_INVALID;
             else
@@ -601,7 +768,7 @@ int MCL_ECPVP_DSA(int sha,mcl_octet *W,mcl_octet *F, mcl_octet *C,mcl_octet *D)
 void MCL_ECP_ECIES_ENCRYPT(int sha,mcl_octet *P1,mcl_octet *P2,csprng *RNG,mcl_octet *W,mcl_octet *M,int tlen,mcl_octet *V,mcl_octet *C,mcl_octet *T)
 { 
 
-	int i,len;
+	int i;
 	char z[MCL_EFS],vz[3*MCL_EFS+2],k[2*MCL_EAS],k1[MCL_EAS],k2[MCL_EAS],l2[8],u[MCL_EFS];
 	mcl_octet Z={0,sizeof(z),z};
 	mcl_octet VZ={0,sizeof(vz),vz};
@@ -610,6 +777,7 @@ void MCL_ECP_ECIES_ENCRYPT(int sha,mcl_octet *P1,mcl_octet *P2,csprng *RNG,mcl_o
 	mcl_octet K2={0,sizeof(k2),k2};
 	mcl_octet L2={0,sizeof(l2),l2};
 	mcl_octet U={0,sizeof(u),u};
+	mcl_hmac H;
 
     if (MCL_ECP_KEY_PAIR_GENERATE(RNG,&U,V)!=0) return;  
     if (MCL_ECPSVDP_DH(&U,W,&Z)!=0) return;     
@@ -626,18 +794,19 @@ void MCL_ECP_ECIES_ENCRYPT(int sha,mcl_octet *P1,mcl_octet *P2,csprng *RNG,mcl_o
 	
 	MCL_OCT_jint(&L2,P2->len,8);
 
-	len=C->len;
-	MCL_OCT_jmcl_octet(C,P2);
-    MCL_OCT_jmcl_octet(C,&L2);
-	MCL_HMAC(sha,C,&K2,tlen,T);
-	C->len=len;
+	MCL_HMAC_init(&H,sha,&K2);
+	MCL_HMAC_update(&H,C->val,C->len);
+	MCL_HMAC_update(&H,P2->val,P2->len);
+	MCL_HMAC_update(&H,L2.val,L2.len);
+	MCL_HMAC_final(&H,tlen,T);
+	MCL_HMAC_kill(&H);
 }
 
 /* IEEE1363 ECIES decryption. Decryption of ciphertext V,C,T using private key U outputs plaintext M */
 int MCL_ECP_ECIES_DECRYPT(int sha,mcl_octet *P1,mcl_octet *P2,mcl_octet *V,mcl_octet *C,mcl_octet *T,mcl_octet *U,mcl_octet *M)
 { 
 
-	int i,len;
+	int i;
 	char z[MCL_EFS],vz[3*MCL_EFS+2],k[2*MCL_EAS],k1[MCL_EAS],k2[MCL_EAS],l2[8],tag[32];
 	mcl_octet Z={0,sizeof(z),z};
 	mcl_octet VZ={0,sizeof(vz),vz};
@@ -646,6 +815,7 @@ int MCL_ECP_ECIES_DECRYPT(int sha,mcl_octet *P1,mcl_octet *P2,mcl_octet *V,mcl_o
 	mcl_octet K2={0,sizeof(k2),k2};
 	mcl_octet L2={0,sizeof(l2),l2};
 	mcl_octet TAG={0,sizeof(tag),tag};
+	mcl_hmac H;
 
 	if (MCL_ECPSVDP_DH(U,V,&Z)!=0) return 0;  
 
@@ -661,11 +831,12 @@ int MCL_ECP_ECIES_DECRYPT(int sha,mcl_octet *P1,mcl_octet *P2,mcl_octet *V,mcl_o
 
 	MCL_OCT_jint(&L2,P2->len,8);
 
-	len=C->len;
-	MCL_OCT_jmcl_octet(C,P2);
-    MCL_OCT_jmcl_octet(C,&L2);	
-	MCL_HMAC(sha,C,&K2,T->len,&TAG);
-	C->len=len;
+	MCL_HMAC_init(&H,sha,&K2);
+	MCL_HMAC_update(&H,C->val,C->len);
+	MCL_HMAC_update(&H,P2->val,P2->len);
+	MCL_HMAC_update(&H,L2.val,L2.len);
+	MCL_HMAC_final(&H,T->len,&TAG);
+	MCL_HMAC_kill(&H);
 
 	if (!MCL_OCT_comp(T,&TAG)) return 0;
 	
@@ -986,6 +986,134 @@ void MCL_ECP_mul(MCL_ECP *P,MCL_BIG e)
 	MCL_ECP_affine(P);
 }
 
+#ifdef MCL_COMB_ORDERBITS
+
+/* Calculate the fixed-base comb table for the generator, as held in ROM */
+void MCL_ECP_gen_comb(MCL_ECP T[])
+{
+	int i,j;
+	mcl_chunk gx[MCL_BS],gy[MCL_BS];
+	MCL_ECP B[MCL_COMB_TEETH];
+
+	MCL_BIG_rcopy(gx,MCL_CURVE_Gx);
+	MCL_BIG_rcopy(gy,MCL_CURVE_Gy);
+	MCL_ECP_set(&B[0],gx,gy);
+
+/* B[i]=2^(i*SPACING).G */
+	for (i=1;i<MCL_COMB_TEETH;i++)
+	{
+		MCL_ECP_copy(&B[i],&B[i-1]);
+		for (j=0;j<MCL_COMB_SPACING;j++)
+			MCL_ECP_dbl(&B[i]);
+	}
+
+	for (j=0;j<MCL_COMB_POINTS;j++)
+	{
+		MCL_ECP_copy(&T[j],&B[MCL_COMB_TEETH-1]);
+		for (i=0;i<MCL_COMB_TEETH-1;i++)
+		{
+			if ((j>>i)&1) MCL_ECP_add(&T[j],&B[i]);
+			else MCL_ECP_sub(&T[j],&B[i]);
+		}
+		MCL_ECP_affine(&T[j]);
+	}
+}
+
+/* Constant time select of entry b from ROM comb table, negated if s=1 */
+static void ECP_gselect(MCL_ECP *P,sign32 b,int s)
+{
+	int i,j;
+	mcl_chunk m,t[MCL_BS];
+	const mcl_chunk *T=MCL_CURVE_GComb;
+
+	MCL_BIG_zero(P->x);
+	MCL_BIG_zero(P->y);
+	for (j=0;j<MCL_COMB_POINTS;j++)
+	{
+		m=-(mcl_chunk)teq(b,j);
+		for (i=0;i<MCL_NLEN;i++)
+		{
+			P->x[i]|=T[i]&m;
+			P->y[i]|=T[MCL_NLEN+i]&m;
+		}
+		T+=2*MCL_NLEN;
+	}
+	MCL_FP_nres(P->x);
+	MCL_FP_nres(P->y);
+	MCL_FP_one(P->z);
+
+	MCL_FP_neg(t,P->x);
+	MCL_BIG_norm(t);
+	MCL_BIG_cmove(P->x,t,s);
+}
+
+/* return bit n of a, no branching */
+static int cbit(MCL_BIG a,int n)
+{
+	return (int)((a[n/MCL_BASEBITS]>>(n%MCL_BASEBITS))&1);
+}
+
+#endif
+
+/* Set P=e*G for the curve generator G */
+void MCL_ECP_mul_gen(MCL_ECP *P,MCL_BIG e)
+{
+#ifdef MCL_COMB_ORDERBITS
+/* signed all-bits-set comb, see mcl_ecp.h */
+	int i,j,s,ns;
+	sign32 u;
+	mcl_chunk k[MCL_BS],mk[MCL_BS];
+	MCL_ECP Q;
+
+/* make multiplier odd - use r-e if e is even, and negate the result */
+	MCL_BIG_rcopy(mk,MCL_CURVE_Order);
+	MCL_BIG_copy(k,e);
+	MCL_BIG_norm(k);
+	MCL_BIG_sub(mk,mk,k); MCL_BIG_norm(mk);
+	ns=1-MCL_BIG_parity(k);
+	MCL_BIG_cmove(k,mk,ns);
+
+/* odd k=sum (2k'_i-1).2^i, where k'=(k-1)/2+2^(TEETH*SPACING-1) */
+	MCL_BIG_fshr(k,1);
+	i=MCL_COMB_TEETH*MCL_COMB_SPACING-1;
+	k[i/MCL_BASEBITS]|=(mcl_chunk)1<<(i%MCL_BASEBITS);
+
+	for (j=MCL_COMB_SPACING-1;j>=0;j--)
+	{
+		s=cbit(k,(MCL_COMB_TEETH-1)*MCL_COMB_SPACING+j);
+		u=0;
+		for (i=0;i<MCL_COMB_TEETH-1;i++)
+			u|=cbit(k,i*MCL_COMB_SPACING+j)<<i;
+		u^=(s-1)&(MCL_COMB_POINTS-1);  /* top digit -1, so take the complement and negate */
+		ECP_gselect(&Q,u,1-s);
+		if (j==MCL_COMB_SPACING-1)
+		{
+			MCL_ECP_copy(P,&Q);
+			continue;
+		}
+		MCL_ECP_dbl(P);
+		MCL_ECP_add(P,&Q);
+	}
+
+	MCL_ECP_copy(&Q,P);
+	MCL_ECP_neg(&Q);
+	ECP_cmove(P,&Q,ns);
+	MCL_ECP_affine(P);
+#else
+	mcl_chunk gx[MCL_BS];
+#if MCL_CURVETYPE!=MCL_MONTGOMERY
+	mcl_chunk gy[MCL_BS];
+	MCL_BIG_rcopy(gx,MCL_CURVE_Gx);
+	MCL_BIG_rcopy(gy,MCL_CURVE_Gy);
+	MCL_ECP_set(P,gx,gy);
+#else
+	MCL_BIG_rcopy(gx,MCL_CURVE_Gx);
+	MCL_ECP_set(P,gx);
+#endif
+	MCL_ECP_mul(P,e);
+#endif
+}
+
 #if MCL_CURVETYPE!=MCL_MONTGOMERY
 /* Set P=eP+fQ double multiplication */
 /* constant time - as useful for GLV method in pairings */
@@ -1065,6 +1193,86 @@ void MCL_ECP_mul2(MCL_ECP *P,MCL_ECP *Q,MCL_BIG e,MCL_BIG f)
 	MCL_ECP_affine(P);
 }
 
+#define ECP_WNAF 5  /* width of wNAF digits for public multipliers */
+
+/* width-w NAF recoding of e into digits in {0,+/-1,+/-3,..,+/-(2^(w-1)-1)}, least significant first. */
+/* Returns number of digits. Not constant time */
+static int ECP_wnaf(sign8 *naf,MCL_BIG e,int w)
+{
+	int n=0,d;
+	mcl_chunk t[MCL_BS];
+
+	MCL_BIG_copy(t,e);
+	MCL_BIG_norm(t);
+	while (!MCL_BIG_iszilch(t))
+	{
+		d=0;
+		if (MCL_BIG_parity(t))
+		{
+			d=MCL_BIG_lastbits(t,w);
+			if (d>=(1<<(w-1))) d-=(1<<w);
+			if (d>0) MCL_BIG_dec(t,d);
+			else MCL_BIG_inc(t,-d);
+			MCL_BIG_norm(t);
+		}
+		naf[n++]=(sign8)d;
+		MCL_BIG_fshr(t,1);
+	}
+	return n;
+}
+
+/* Set P=eP+fQ double multiplication, interleaved wNAF */
+/* NOT constant time - only for public multipliers, as in signature verification */
+void MCL_ECP_mul2_vartime(MCL_ECP *P,MCL_ECP *Q,MCL_BIG e,MCL_BIG f)
+{
+	int i,a,b,ne,nf;
+	sign8 we[2+MCL_NLEN*MCL_BASEBITS],wf[2+MCL_NLEN*MCL_BASEBITS];
+	MCL_ECP S,WP[1<<(ECP_WNAF-2)],WQ[1<<(ECP_WNAF-2)];
+#if MCL_CURVETYPE==MCL_WEIERSTRASS
+	mcl_chunk work[1<<(ECP_WNAF-2)][MCL_BS];
+#endif
+
+	MCL_ECP_affine(P);
+	MCL_ECP_affine(Q);
+
+/* precompute odd multiples P,3P,5P.. and Q,3Q,5Q.. */
+	MCL_ECP_copy(&WP[0],P);
+	MCL_ECP_copy(&S,P); MCL_ECP_dbl(&S);
+	for (i=1;i<(1<<(ECP_WNAF-2));i++)
+	{
+		MCL_ECP_copy(&WP[i],&WP[i-1]);
+		MCL_ECP_add(&WP[i],&S);
+	}
+	MCL_ECP_copy(&WQ[0],Q);
+	MCL_ECP_copy(&S,Q); MCL_ECP_dbl(&S);
+	for (i=1;i<(1<<(ECP_WNAF-2));i++)
+	{
+		MCL_ECP_copy(&WQ[i],&WQ[i-1]);
+		MCL_ECP_add(&WQ[i],&S);
+	}
+
+#if MCL_CURVETYPE==MCL_WEIERSTRASS
+	ECP_multiaffine(1<<(ECP_WNAF-2),WP,work);
+	ECP_multiaffine(1<<(ECP_WNAF-2),WQ,work);
+#endif
+
+	ne=ECP_wnaf(we,e,ECP_WNAF);
+	nf=ECP_wnaf(wf,f,ECP_WNAF);
+
+	MCL_ECP_inf(P);
+	for (i=(ne>nf?ne:nf)-1;i>=0;i--)
+	{
+		MCL_ECP_dbl(P);
+		a=(i<ne) ? we[i] : 0;
+		b=(i<nf) ? wf[i] : 0;
+		if (a>0) MCL_ECP_add(P,&WP[(a-1)/2]);
+		if (a<0) MCL_ECP_sub(P,&WP[(-a-1)/2]);
+		if (b>0) MCL_ECP_add(P,&WQ[(b-1)/2]);
+		if (b<0) MCL_ECP_sub(P,&WQ[(-b-1)/2]);
+	}
+	MCL_ECP_affine(P);
+}
+
 #endif
 
 #ifdef HAS_MAIN
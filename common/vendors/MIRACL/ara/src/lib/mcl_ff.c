@@ -813,6 +813,72 @@ static void MCL_FF_modsqr(mcl_chunk z[][MCL_BS],mcl_chunk x[][MCL_BS],mcl_chunk
 	FF_reduce(z,d,p,ND,n);
 }
 
+#if MCL_FF_WINDOW>0
+
+/* return 1 if b==c, no branching */
+static int teq(sign32 b,sign32 c)
+{
+	sign32 x=b^c;
+	x-=1;  // if x=0, x now -1
+	return (int)((x>>31)&1);
+}
+
+/* Constant time r=T[d], for a table of m FFs. Every entry is read */
+static void FF_select(mcl_chunk r[][MCL_BS],mcl_chunk T[][MCL_BS],int d,int m,int n)
+{
+	int i,j;
+	for (i=0;i<m;i++)
+		for (j=0;j<n;j++)
+			MCL_BIG_cmove(r[j],T[i*n+j],teq(i,d));
+}
+
+/* bits i+w-1 .. i of e, as an integer. Bits at or above nb are 0 */
+static int FF_window(mcl_chunk e[][MCL_BS],int i,int w,int nb)
+{
+	int j,d=0;
+	for (j=w-1;j>=0;j--)
+	{
+		d<<=1;
+		if (i+j<nb) d|=MCL_BIG_bit(e[(i+j)/MCL_BIGBITS],(i+j)%MCL_BIGBITS);
+	}
+	return d;
+}
+
+/* r=x^e mod p, side-channel resistant, for large e. Fixed window: the same squarings and
+   multiplications whatever e is, with every multiplier read out of the table of
+   x^0..x^(2^MCL_FF_WINDOW-1) in constant time */
+void MCL_FF_skpow(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],mcl_chunk e[][MCL_BS],mcl_chunk p[][MCL_BS],int n)
+{
+	int i,j,nb=8*MCL_MODBYTES*n;
+#ifndef C99
+	mcl_chunk T[(1<<MCL_FF_WINDOW)*MCL_FFLEN][MCL_BS],w[MCL_FFLEN][MCL_BS],ND[MCL_FFLEN][MCL_BS];
+#else
+	mcl_chunk T[(1<<MCL_FF_WINDOW)*n][MCL_BS],w[n][MCL_BS],ND[n][MCL_BS];
+#endif
+	FF_invmod2m(ND,p,n);
+
+	MCL_FF_one(T,n);
+	MCL_FF_copy(&T[n],x,n);
+	FF_nres(T,p,n);
+	FF_nres(&T[n],p,n);
+	for (i=2;i<(1<<MCL_FF_WINDOW);i++)
+		MCL_FF_modmul(&T[i*n],&T[(i-1)*n],&T[n],p,ND,n);
+
+/* top window first, then MCL_FF_WINDOW squarings and one multiplication per window */
+	i=((nb-1)/MCL_FF_WINDOW)*MCL_FF_WINDOW;
+	FF_select(r,T,FF_window(e,i,MCL_FF_WINDOW,nb),1<<MCL_FF_WINDOW,n);
+	for (i-=MCL_FF_WINDOW;i>=0;i-=MCL_FF_WINDOW)
+	{
+		for (j=0;j<MCL_FF_WINDOW;j++)
+			MCL_FF_modsqr(r,r,p,ND,n);
+		FF_select(w,T,FF_window(e,i,MCL_FF_WINDOW,nb),1<<MCL_FF_WINDOW,n);
+		MCL_FF_modmul(r,r,w,p,ND,n);
+	}
+	FF_redc(r,p,ND,n);
+}
+
+#else
+
 /* r=x^e mod p using side-channel resistant Montgomery Ladder, for large e */
 void MCL_FF_skpow(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],mcl_chunk e[][MCL_BS],mcl_chunk p[][MCL_BS],int n)
 {
@@ -844,6 +910,8 @@ void MCL_FF_skpow(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],mcl_chunk e[][MCL_
 	FF_redc(r,p,ND,n);
 }
 
+#endif
+
 /* r=x^e mod p using side-channel resistant Montgomery Ladder, for short e */
 void MCL_FF_skspow(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],MCL_BIG e,mcl_chunk p[][MCL_BS],int n)
 {
@@ -905,6 +973,100 @@ void MCL_FF_power(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],int e,mcl_chunk p[
 	FF_redc(r,p,ND,n);
 }
 
+/* Montgomery constants of p, for repeated use by MCL_FF_mont_power */
+void MCL_FF_mont_init(MCL_ff_mont *M,mcl_chunk p[][MCL_BS],int n)
+{
+	M->n=n;
+	MCL_FF_copy(M->p,p,n);
+	FF_invmod2m(M->ND,p,n);
+	MCL_FF_one(M->R2,n);
+	FF_nres(M->R2,p,n);
+	FF_nres(M->R2,p,n);
+}
+
+/* r=x^e mod p as MCL_FF_power, but x goes to n-residue form by a Montgomery */
+/* multiplication by R^2 rather than by a long division */
+void MCL_FF_mont_power(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],int e,MCL_ff_mont *M)
+{
+	int f=1,n=M->n;
+#ifndef C99
+	mcl_chunk w[MCL_FFLEN][MCL_BS],p[MCL_FFLEN][MCL_BS];
+#else
+	mcl_chunk w[n][MCL_BS],p[n][MCL_BS];
+#endif
+	MCL_FF_copy(p,M->p,n); /* MCL_FF_mod shifts the modulus in place, so M must not be passed to it */
+	MCL_FF_copy(w,x,n);
+	MCL_FF_modmul(w,w,M->R2,p,M->ND,n);
+
+	if (e==2)
+	{
+		MCL_FF_modsqr(r,w,p,M->ND,n);
+	}
+	else for (;;)
+	{
+		if (e%2==1) 
+		{
+			if (f) MCL_FF_copy(r,w,n);
+			else MCL_FF_modmul(r,r,w,p,M->ND,n);
+			f=0;
+		}
+		e>>=1;
+		if (e==0) break;
+		MCL_FF_modsqr(w,w,p,M->ND,n);
+	}
+
+	FF_redc(r,p,M->ND,n);
+}
+
+#if MCL_FF_WINDOW>0
+
+/* r=x^e mod p, faster but not side channel resistant. Sliding window: runs of zero bits
+   cost only squarings, and each window of up to MCL_FF_WINDOW bits starting and ending
+   with a one costs one multiplication, by an odd power x^1..x^(2^MCL_FF_WINDOW-1) */
+void MCL_FF_pow(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],mcl_chunk e[][MCL_BS],mcl_chunk p[][MCL_BS],int n)
+{
+	int i,j,k,d,f=1;
+#ifndef C99
+	mcl_chunk T[(1<<(MCL_FF_WINDOW-1))*MCL_FFLEN][MCL_BS],x2[MCL_FFLEN][MCL_BS],ND[MCL_FFLEN][MCL_BS];
+#else
+	mcl_chunk T[(1<<(MCL_FF_WINDOW-1))*n][MCL_BS],x2[n][MCL_BS],ND[n][MCL_BS];
+#endif
+	FF_invmod2m(ND,p,n);
+	MCL_FF_copy(T,x,n);
+	FF_nres(T,p,n);
+	MCL_FF_modsqr(x2,T,p,ND,n);
+	for (i=1;i<(1<<(MCL_FF_WINDOW-1));i++)
+		MCL_FF_modmul(&T[i*n],&T[(i-1)*n],x2,p,ND,n);  /* x^(2i+1) */
+	MCL_FF_one(r,n);
+	FF_nres(r,p,n);
+
+	for (i=8*MCL_MODBYTES*n-1;i>=0;)
+	{
+		if (!MCL_BIG_bit(e[i/MCL_BIGBITS],i%MCL_BIGBITS))
+		{
+			if (!f) MCL_FF_modsqr(r,r,p,ND,n);
+			i--;
+			continue;
+		}
+	/* the window is bits i..k, the lowest set bit within MCL_FF_WINDOW of i */
+		k=i-MCL_FF_WINDOW+1;
+		if (k<0) k=0;
+		while (!MCL_BIG_bit(e[k/MCL_BIGBITS],k%MCL_BIGBITS)) k++;
+		d=FF_window(e,k,i-k+1,8*MCL_MODBYTES*n);
+		if (f) MCL_FF_copy(r,&T[(d>>1)*n],n);
+		else
+		{
+			for (j=k;j<=i;j++) MCL_FF_modsqr(r,r,p,ND,n);
+			MCL_FF_modmul(r,r,&T[(d>>1)*n],p,ND,n);
+		}
+		f=0;
+		i=k-1;
+	}
+	FF_redc(r,p,ND,n);
+}
+
+#else
+
 /* r=x^e mod p, faster but not side channel resistant */
 void MCL_FF_pow(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],mcl_chunk e[][MCL_BS],mcl_chunk p[][MCL_BS],int n)
 {
@@ -929,6 +1091,8 @@ void MCL_FF_pow(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],mcl_chunk e[][MCL_BS
 	FF_redc(r,p,ND,n);
 }
 
+#endif
+
 /* double exponentiation r=x^e.y^f mod p */
 void MCL_FF_pow2(mcl_chunk r[][MCL_BS],mcl_chunk x[][MCL_BS],MCL_BIG e,mcl_chunk y[][MCL_BS],MCL_BIG f,mcl_chunk p[][MCL_BS],int n)
 {
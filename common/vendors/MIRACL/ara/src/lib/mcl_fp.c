@@ -124,27 +124,43 @@ void MCL_FP10_mod(MCL_BIG r,DMCL_BIG d)
 /* This only applies to Curve MCL_C448, so specialised (for now) */
 #if MCL_MODTYPE == MCL_GENERALISED_MERSENNE
 
+#define HBITS (MCL_MBITS/2)	/**< p=2^448-2^224-1=f^2-f-1 where f=2^HBITS */
+
 void MCL_FP_nres(MCL_BIG a) {}
 
 void MCL_FP_redc(MCL_BIG a) {}
 
 /* reduce a DMCL_BIG to a MCL_BIG exploiting the special form of the modulus */
+/* With f=2^224, f^2=f+1 mod p. So t.f^2+b = b+t+t.f, and with t=h.f+l this is b+l+h+(l+2h).f  */
+/* A second fold of the few bits left above 2^448 leaves an excess of at most 1, so that products
+   of products rarely need a full MCL_FP_reduce */
 void MCL_FP10_mod(MCL_BIG r,DMCL_BIG d)
 {
-	mcl_chunk t[MCL_BS],b[MCL_BS];
+	int i;
+	mcl_chunk t[MCL_BS],b[MCL_BS],h[MCL_BS];
+	mcl_chunk top;
 
 	MCL_BIG_split(t,b,d,MCL_MBITS); 
 
-	MCL_BIG_add(r,t,b);
-	MCL_BIG_dscopy(d,t);
-	MCL_BIG_dshl(d,MCL_MBITS/2);
-
-	MCL_BIG_split(t,b,d,MCL_MBITS);
+	MCL_BIG_copy(h,t);
+	MCL_BIG_shr(h,HBITS);
+	t[HBITS/MCL_BASEBITS]&=(((mcl_chunk)1<<(HBITS%MCL_BASEBITS))-1);
+	for (i=HBITS/MCL_BASEBITS+1;i<MCL_NLEN;i++) t[i]=0;
+
+	MCL_BIG_add(r,b,t);
+	MCL_BIG_add(r,r,h);
+	MCL_BIG_add(t,t,h);
+	MCL_BIG_add(t,t,h);
+	MCL_BIG_norm(t);
+	MCL_BIG_shl(t,HBITS);
 	MCL_BIG_add(r,r,t);
-	MCL_BIG_add(r,r,b);
-	MCL_BIG_shl(t,MCL_MBITS/2);
+	MCL_BIG_norm(r);
 
-	MCL_BIG_add(r,r,t);
+	top=r[MCL_NLEN-1]>>TBITS;
+	r[MCL_NLEN-1]&=TMASK;
+	r[0]+=top;
+	r[HBITS/MCL_BASEBITS]+=(top<<(HBITS%MCL_BASEBITS))&BMASK;
+	r[HBITS/MCL_BASEBITS+1]+=top>>(MCL_BASEBITS-HBITS%MCL_BASEBITS);
 
 	MCL_BIG_norm(r);
 }
@@ -86,6 +86,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
 #define F2(x,y,z) ((x&y) | (z&(x|y))) 
 #define F3(x,y,z) (x^y^z)
 
+/* load a 64-byte block into w[0..15] as big-endian words */
+static void MCL_HASH_load32(unsign32 *w,const unsigned char *b)
+{
+    int i;
+    for (i=0;i<16;i++,b+=4)
+        w[i]=((unsign32)b[0]<<24)|((unsign32)b[1]<<16)|((unsign32)b[2]<<8)|(unsign32)b[3];
+}
+
 static void MCL_HASH160_transform(mcl_hash160 *sh)
 { /* basic transformation step */
     unsign32 a,b,c,d,e,temp;
@@ -156,6 +164,29 @@ void MCL_HASH160_process(mcl_hash160 *sh,int byte)
     if ((sh->length[0]%512)==0) MCL_HASH160_transform(sh);
 }
 
+/* process an array of bytes, whole blocks go straight to the transform */
+void MCL_HASH160_process_array(mcl_hash160 *sh,const char *b,int len)
+{
+    const unsigned char *p=(const unsigned char *)b;
+
+    while (len>0 && (sh->length[0]%512)!=0)
+    { /* top up a partial block */
+        MCL_HASH160_process(sh,*p++); len--;
+    }
+    while (len>=64)
+    {
+        MCL_HASH_load32(sh->w,p);
+        sh->length[0]+=512;
+        if (sh->length[0]==0L) sh->length[1]++;
+        MCL_HASH160_transform(sh);
+        p+=64; len-=64;
+    }
+    while (len>0)
+    {
+        MCL_HASH160_process(sh,*p++); len--;
+    }
+}
+
 void MCL_HASH160_hash(mcl_hash160 *sh,char *hash)
 { /* pad message and finish - supply digest */
     int i;
@@ -215,11 +246,46 @@ static const unsign32 K_256[64]={
 
 
 
+#ifdef MCL_HASH_X86
+/* mcl_hash_x86.c */
+extern int MCL_HASH_x86_detect(void);
+extern void MCL_HASH256_transform_shani(unsign32 *h,const unsign32 *w);
+extern void MCL_HASH256_multi_avx2(int n,const char *m[],const int len[],char *h);
+#endif
+
+static int hash_features=-1; /* -1 until the CPU has been probed */
+
+int MCL_HASH_features(void)
+{
+#ifdef MCL_HASH_X86
+    if (hash_features<0) hash_features=MCL_HASH_x86_detect();
+    return hash_features;
+#else
+    return 0;
+#endif
+}
+
+void MCL_HASH_set_features(int mask)
+{
+#ifdef MCL_HASH_X86
+    hash_features=MCL_HASH_x86_detect()&mask;
+#else
+    hash_features=0;
+#endif
+}
+
 /* SU= 72 */
 static void MCL_HASH256_transform(mcl_hash256 *sh)
 { /* basic transformation step */
     unsign32 a,b,c,d,e,f,g,h,t1,t2;
     int j;
+#ifdef MCL_HASH_X86
+    if (MCL_HASH_features()&MCL_HASH_SHANI)
+    {
+        MCL_HASH256_transform_shani(sh->h,sh->w);
+        return;
+    }
+#endif
     for (j=16;j<64;j++) 
         sh->w[j]=theta1_256(sh->w[j-2])+sh->w[j-7]+theta0_256(sh->w[j-15])+sh->w[j-16];
 
@@ -275,6 +341,29 @@ void MCL_HASH256_process(mcl_hash256 *sh,int byte)
     if ((sh->length[0]%512)==0) MCL_HASH256_transform(sh);
 }
 
+/* process an array of bytes, whole blocks go straight to the transform */
+void MCL_HASH256_process_array(mcl_hash256 *sh,const char *b,int len)
+{
+    const unsigned char *p=(const unsigned char *)b;
+
+    while (len>0 && (sh->length[0]%512)!=0)
+    { /* top up a partial block */
+        MCL_HASH256_process(sh,*p++); len--;
+    }
+    while (len>=64)
+    {
+        MCL_HASH_load32(sh->w,p);
+        sh->length[0]+=512;
+        if (sh->length[0]==0L) sh->length[1]++;
+        MCL_HASH256_transform(sh);
+        p+=64; len-=64;
+    }
+    while (len>0)
+    {
+        MCL_HASH256_process(sh,*p++); len--;
+    }
+}
+
 /* SU= 24 */
 /* Generate 32-byte Hash */
 void MCL_HASH256_hash(mcl_hash256 *sh,char *digest)
@@ -295,6 +384,30 @@ void MCL_HASH256_hash(mcl_hash256 *sh,char *digest)
     MCL_HASH256_init(sh);
 }
 
+/* hash n messages, eight at a time if AVX2 is available */
+void MCL_HASH256_multi(int n,const char *m[],const int len[],char *h)
+{
+    int i,k;
+    mcl_hash256 sh;
+
+    for (i=0;i<n;i+=k)
+    {
+        k=n-i;
+#ifdef MCL_HASH_X86
+        if (k>1 && (MCL_HASH_features()&MCL_HASH_AVX2))
+        {
+            if (k>8) k=8;
+            MCL_HASH256_multi_avx2(k,&m[i],&len[i],&h[32*i]);
+            continue;
+        }
+#endif
+        k=1;
+        MCL_HASH256_init(&sh);
+        MCL_HASH256_process_array(&sh,m[i],len[i]);
+        MCL_HASH256_hash(&sh,&h[32*i]);
+    }
+}
+
 
 #define H0_512 0x6a09e667f3bcc908 
 #define H1_512 0xbb67ae8584caa73b 
@@ -339,6 +452,93 @@ static const unsign64 K_512[80]=
 0x4cc5d4becb3e42b6 ,0x597f299cfc657e2a ,0x5fcb6fab3ad6faec ,0x6c44198c4a475817 };
 
 
+/* On 32-bit processors, define MCL_HASH512_SPLIT (CONFIG_HASH512_SPLIT=y in
+   defconfig) to do the transform on hi/lo pairs of 32-bit words, with the
+   rounds unrolled eight at a time, since every unsign64 rotate and add is a
+   multi-instruction sequence there. It is off by default: on the hosts
+   measured so far it is no faster on i386, about 3x slower on x86-64 and
+   about 9x larger, so only enable it where it has been measured to win on
+   the target core */
+
+#if MCL_CHUNK==32 && defined(MCL_HASH512_SPLIT)
+
+/* r=x+y on hi/lo pairs */
+#define ADD64(rh,rl,xh,xl,yh,yl) { unsign32 t_=(xl); rl=t_+(yl); rh=(xh)+(yh)+(rl<t_); }
+/* r=ROTR(x,n) for 0<n<32, and for 32<n<64 */
+#define RLO(xh,xl,n) (((xl)>>(n))|((xh)<<(32-(n))))
+#define RHI(xh,xl,n) (((xh)>>(n))|((xl)<<(32-(n))))
+
+#define SIG0H(xh,xl) (RHI(xh,xl,28)^RHI(xl,xh,2)^RHI(xl,xh,7))
+#define SIG0L(xh,xl) (RLO(xh,xl,28)^RLO(xl,xh,2)^RLO(xl,xh,7))
+#define SIG1H(xh,xl) (RHI(xh,xl,14)^RHI(xh,xl,18)^RHI(xl,xh,9))
+#define SIG1L(xh,xl) (RLO(xh,xl,14)^RLO(xh,xl,18)^RLO(xl,xh,9))
+#define THETA0H(xh,xl) (RHI(xh,xl,1)^RHI(xh,xl,8)^((xh)>>7))
+#define THETA0L(xh,xl) (RLO(xh,xl,1)^RLO(xh,xl,8)^RLO(xh,xl,7))
+#define THETA1H(xh,xl) (RHI(xh,xl,19)^RHI(xl,xh,29)^((xh)>>6))
+#define THETA1L(xh,xl) (RLO(xh,xl,19)^RLO(xl,xh,29)^RLO(xh,xl,6))
+
+/* w[j]+=theta1(w[j-2])+w[j-7]+theta0(w[j-15]), in a rolling 16 word schedule */
+#define SCHED(j) { \
+    unsign32 uh,ul; \
+    ADD64(uh,ul,THETA1H(wh[((j)-2)&15],wl[((j)-2)&15]),THETA1L(wh[((j)-2)&15],wl[((j)-2)&15]),wh[((j)-7)&15],wl[((j)-7)&15]); \
+    ADD64(uh,ul,uh,ul,THETA0H(wh[((j)-15)&15],wl[((j)-15)&15]),THETA0L(wh[((j)-15)&15],wl[((j)-15)&15])); \
+    ADD64(wh[(j)&15],wl[(j)&15],wh[(j)&15],wl[(j)&15],uh,ul); }
+
+/* one round, with the state rotated by renaming rather than moving */
+#define RND(a,b,c,d,e,f,g,h,j) { \
+    unsign32 th,tl; \
+    ADD64(th,tl,h##_h,h##_l,SIG1H(e##_h,e##_l),SIG1L(e##_h,e##_l)); \
+    ADD64(th,tl,th,tl,Ch(e##_h,f##_h,g##_h),Ch(e##_l,f##_l,g##_l)); \
+    ADD64(th,tl,th,tl,(unsign32)(K_512[j]>>32),(unsign32)K_512[j]); \
+    ADD64(th,tl,th,tl,wh[(j)&15],wl[(j)&15]); \
+    ADD64(d##_h,d##_l,d##_h,d##_l,th,tl); \
+    ADD64(th,tl,th,tl,SIG0H(a##_h,a##_l),SIG0L(a##_h,a##_l)); \
+    ADD64(h##_h,h##_l,th,tl,Maj(a##_h,b##_h,c##_h),Maj(a##_l,b##_l,c##_l)); }
+
+#define RND8(j) \
+    RND(a,b,c,d,e,f,g,h,(j)); \
+    RND(h,a,b,c,d,e,f,g,(j)+1); \
+    RND(g,h,a,b,c,d,e,f,(j)+2); \
+    RND(f,g,h,a,b,c,d,e,(j)+3); \
+    RND(e,f,g,h,a,b,c,d,(j)+4); \
+    RND(d,e,f,g,h,a,b,c,(j)+5); \
+    RND(c,d,e,f,g,h,a,b,(j)+6); \
+    RND(b,c,d,e,f,g,h,a,(j)+7)
+
+static void MCL_HASH512_transform(mcl_hash512 *sh)
+{ /* basic transformation step, 32-bit registers */
+    unsign32 a_h,a_l,b_h,b_l,c_h,c_l,d_h,d_l,e_h,e_l,f_h,f_l,g_h,g_l,h_h,h_l;
+    unsign32 wh[16],wl[16];
+    int i,j;
+
+    for (i=0;i<16;i++)
+    {
+        wh[i]=(unsign32)(sh->w[i]>>32);
+        wl[i]=(unsign32)sh->w[i];
+    }
+    a_h=(unsign32)(sh->h[0]>>32); a_l=(unsign32)sh->h[0];
+    b_h=(unsign32)(sh->h[1]>>32); b_l=(unsign32)sh->h[1];
+    c_h=(unsign32)(sh->h[2]>>32); c_l=(unsign32)sh->h[2];
+    d_h=(unsign32)(sh->h[3]>>32); d_l=(unsign32)sh->h[3];
+    e_h=(unsign32)(sh->h[4]>>32); e_l=(unsign32)sh->h[4];
+    f_h=(unsign32)(sh->h[5]>>32); f_l=(unsign32)sh->h[5];
+    g_h=(unsign32)(sh->h[6]>>32); g_l=(unsign32)sh->h[6];
+    h_h=(unsign32)(sh->h[7]>>32); h_l=(unsign32)sh->h[7];
+
+    for (j=0;j<80;j+=8)
+    { /* 80 times - mush it up */
+        if (j>=16) for (i=j;i<j+8;i++) SCHED(i);
+        RND8(j);
+    }
+
+    sh->h[0]+=((unsign64)a_h<<32)|a_l; sh->h[1]+=((unsign64)b_h<<32)|b_l;
+    sh->h[2]+=((unsign64)c_h<<32)|c_l; sh->h[3]+=((unsign64)d_h<<32)|d_l;
+    sh->h[4]+=((unsign64)e_h<<32)|e_l; sh->h[5]+=((unsign64)f_h<<32)|f_l;
+    sh->h[6]+=((unsign64)g_h<<32)|g_l; sh->h[7]+=((unsign64)h_h<<32)|h_l;
+}
+
+#else
+
 static void MCL_HASH512_transform(mcl_hash512 *sh)
 { /* basic transformation step */
     unsign64 a,b,c,d,e,f,g,h,t1,t2;
@@ -364,6 +564,8 @@ static void MCL_HASH512_transform(mcl_hash512 *sh)
     sh->h[4]+=e; sh->h[5]+=f; sh->h[6]+=g; sh->h[7]+=h; 
 } 
 
+#endif
+
 void MCL_HASH384_init(mcl_hash384 *sh)
 { /* re-initialise */
     int i;
@@ -387,6 +589,11 @@ void MCL_HASH384_process(mcl_hash384 *sh,int byte)
 	MCL_HASH512_process(sh,byte);
 }
 
+void MCL_HASH384_process_array(mcl_hash384 *sh,const char *b,int len)
+{ /* process an array of bytes */
+	MCL_HASH512_process_array(sh,b,len);
+}
+
 void MCL_HASH384_hash(mcl_hash384 *sh,char *hash)
 { /* pad message and finish - supply digest */
 	MCL_HASH512_hash(sh,hash);
@@ -424,6 +631,34 @@ void MCL_HASH512_process(mcl_hash512 *sh,int byte)
     if ((sh->length[0]%1024)==0) MCL_HASH512_transform(sh);
 }
 
+/* process an array of bytes, whole blocks go straight to the transform */
+void MCL_HASH512_process_array(mcl_hash512 *sh,const char *b,int len)
+{
+    int i,j;
+    const unsigned char *p=(const unsigned char *)b;
+
+    while (len>0 && (sh->length[0]%1024)!=0)
+    { /* top up a partial block */
+        MCL_HASH512_process(sh,*p++); len--;
+    }
+    while (len>=128)
+    {
+        for (i=0;i<16;i++)
+        {
+            sh->w[i]=0;
+            for (j=0;j<8;j++) sh->w[i]=(sh->w[i]<<8)|(unsign64)*p++;
+        }
+        sh->length[0]+=1024;
+        if (sh->length[0]==0L) sh->length[1]++;
+        MCL_HASH512_transform(sh);
+        len-=128;
+    }
+    while (len>0)
+    {
+        MCL_HASH512_process(sh,*p++); len--;
+    }
+}
+
 void MCL_HASH512_hash(mcl_hash512 *sh,char *hash)
 { /* pad message and finish - supply digest */
     int i;
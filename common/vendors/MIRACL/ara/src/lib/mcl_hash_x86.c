@@ -0,0 +1,260 @@
+/*************************************************************************
+                                                                         *
+Copyright (c) 2015>, MIRACL Ltd                                          *
+All rights reserved.                                                     *
+                                                                         *
+This file is derived from the MIRACL for Ara SDK.                        *
+                                                                         *
+The MIRACL for Ara SDK provides developers with an                       *
+extensive and efficient set of cryptographic functions.                  *
+For further information about its features and functionalities           *
+please refer to https://www.miracl.com                                   *
+                                                                         *
+Redistribution and use in source and binary forms, with or without       *
+modification, are permitted provided that the following conditions are   *
+met:                                                                     *
+                                                                         *
+ 1. Redistributions of source code must retain the above copyright       *
+    notice, this list of conditions and the following disclaimer.        *
+                                                                         *
+ 2. Redistributions in binary form must reproduce the above copyright    *
+    notice, this list of conditions and the following disclaimer in the  *
+    documentation and/or other materials provided with the distribution. *
+                                                                         *
+ 3. Neither the name of the copyright holder nor the names of its        *
+    contributors may be used to endorse or promote products derived      *
+    from this software without specific prior written permission.        *
+                                                                         *
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS  *
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED    *
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A          *
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT       *
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,   *
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED *
+TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR   *
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF   *
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     *
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS       *
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
+                                                                         *
+**************************************************************************/
+
+
+/*
+ * x86 SHA-256 code paths for the host build of the library
+ *
+ * MCL_HASH256_transform_shani() runs one block through the SHA extensions,
+ * MCL_HASH256_multi_avx2() hashes up to eight independent messages at once,
+ * one per 32-bit lane of the AVX2 registers. Both are only called once
+ * MCL_HASH_x86_detect() has confirmed that the CPU (and OS) support them,
+ * see MCL_HASH_features() in mcl_hash.c
+ */
+
+#include "mcl_arch.h"
+#include "mcl_hash.h"
+
+#ifdef MCL_HASH_X86
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+static const unsign32 K_256[64]={
+0x428a2f98L,0x71374491L,0xb5c0fbcfL,0xe9b5dba5L,0x3956c25bL,0x59f111f1L,0x923f82a4L,0xab1c5ed5L,
+0xd807aa98L,0x12835b01L,0x243185beL,0x550c7dc3L,0x72be5d74L,0x80deb1feL,0x9bdc06a7L,0xc19bf174L,
+0xe49b69c1L,0xefbe4786L,0x0fc19dc6L,0x240ca1ccL,0x2de92c6fL,0x4a7484aaL,0x5cb0a9dcL,0x76f988daL,
+0x983e5152L,0xa831c66dL,0xb00327c8L,0xbf597fc7L,0xc6e00bf3L,0xd5a79147L,0x06ca6351L,0x14292967L,
+0x27b70a85L,0x2e1b2138L,0x4d2c6dfcL,0x53380d13L,0x650a7354L,0x766a0abbL,0x81c2c92eL,0x92722c85L,
+0xa2bfe8a1L,0xa81a664bL,0xc24b8b70L,0xc76c51a3L,0xd192e819L,0xd6990624L,0xf40e3585L,0x106aa070L,
+0x19a4c116L,0x1e376c08L,0x2748774cL,0x34b0bcb5L,0x391c0cb3L,0x4ed8aa4aL,0x5b9cca4fL,0x682e6ff3L,
+0x748f82eeL,0x78a5636fL,0x84c87814L,0x8cc70208L,0x90befffaL,0xa4506cebL,0xbef9a3f7L,0xc67178f2L};
+
+static const unsign32 H_256[8]={
+0x6A09E667L,0xBB67AE85L,0x3C6EF372L,0xA54FF53AL,0x510E527FL,0x9B05688CL,0x1F83D9ABL,0x5BE0CD19L};
+
+/* XCR0 - which register sets the OS saves on a context switch */
+static unsign32 MCL_HASH_xgetbv(void)
+{
+    unsign32 lo,hi;
+    __asm__ volatile ("xgetbv" : "=a"(lo),"=d"(hi) : "c"(0));
+    return lo;
+}
+
+/* Find out which of the x86 hash code paths this CPU can run */
+int MCL_HASH_x86_detect(void)
+{
+    unsigned int a,b,c,d,ecx1;
+    int features=0;
+
+    if (!__get_cpuid(1,&a,&b,&ecx1,&d)) return 0;
+    if (__get_cpuid_max(0,NULL)<7) return 0;
+    __cpuid_count(7,0,a,b,c,d);
+
+    if ((b&bit_SHA) && (ecx1&bit_SSSE3) && (ecx1&bit_SSE4_1))
+        features|=MCL_HASH_SHANI;
+    /* AVX2 also needs the OS to save the YMM registers */
+    if ((b&bit_AVX2) && (ecx1&bit_AVX) && (ecx1&bit_OSXSAVE) && (MCL_HASH_xgetbv()&6)==6)
+        features|=MCL_HASH_AVX2;
+    return features;
+}
+
+/* One block with the SHA extensions. w[0..15] holds the block as host order words */
+__attribute__((target("sha,ssse3,sse4.1")))
+void MCL_HASH256_transform_shani(unsign32 *h,const unsign32 *w)
+{
+    __m128i state0,state1,abef,cdgh,msg,tmp;
+    __m128i m[4];
+    int j;
+
+    /* h[] is ABCD EFGH, the instructions want ABEF and CDGH */
+    tmp=_mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&h[0]),0xB1);
+    state1=_mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&h[4]),0x1B);
+    state0=_mm_alignr_epi8(tmp,state1,8);
+    state1=_mm_blend_epi16(state1,tmp,0xF0);
+    abef=state0; cdgh=state1;
+
+    for (j=0;j<4;j++) m[j]=_mm_loadu_si128((const __m128i *)&w[4*j]);
+
+    for (j=0;j<16;j++)
+    { /* 4 rounds at a time, building the schedule 4 words ahead */
+        if (j>=4)
+        {
+            tmp=_mm_sha256msg1_epu32(m[j&3],m[(j+1)&3]);
+            tmp=_mm_add_epi32(tmp,_mm_alignr_epi8(m[(j+3)&3],m[(j+2)&3],4));
+            m[j&3]=_mm_sha256msg2_epu32(tmp,m[(j+3)&3]);
+        }
+        msg=_mm_add_epi32(m[j&3],_mm_loadu_si128((const __m128i *)&K_256[4*j]));
+        state1=_mm_sha256rnds2_epu32(state1,state0,msg);
+        msg=_mm_shuffle_epi32(msg,0x0E);
+        state0=_mm_sha256rnds2_epu32(state0,state1,msg);
+    }
+
+    state0=_mm_add_epi32(state0,abef);
+    state1=_mm_add_epi32(state1,cdgh);
+
+    /* back to ABCD EFGH */
+    tmp=_mm_shuffle_epi32(state0,0x1B);
+    state1=_mm_shuffle_epi32(state1,0xB1);
+    _mm_storeu_si128((__m128i *)&h[0],_mm_blend_epi16(tmp,state1,0xF0));
+    _mm_storeu_si128((__m128i *)&h[4],_mm_alignr_epi8(state1,tmp,8));
+}
+
+#define ROTR8(x,n) _mm256_or_si256(_mm256_srli_epi32(x,n),_mm256_slli_epi32(x,32-(n)))
+#define CH8(x,y,z) _mm256_xor_si256(_mm256_and_si256(x,_mm256_xor_si256(y,z)),z)
+#define MAJ8(x,y,z) _mm256_or_si256(_mm256_and_si256(x,y),_mm256_and_si256(z,_mm256_or_si256(x,y)))
+#define SIG0_8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR8(x,2),ROTR8(x,13)),ROTR8(x,22))
+#define SIG1_8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR8(x,6),ROTR8(x,11)),ROTR8(x,25))
+#define THETA0_8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR8(x,7),ROTR8(x,18)),_mm256_srli_epi32(x,3))
+#define THETA1_8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR8(x,17),ROTR8(x,19)),_mm256_srli_epi32(x,10))
+
+/* big-endian word t of each of the eight 64-byte blocks */
+__attribute__((target("avx2")))
+static __m256i MCL_HASH256_gather8(const unsigned char *blk[8],int t)
+{
+    unsign32 v[8];
+    int l;
+    for (l=0;l<8;l++)
+    {
+        const unsigned char *p=blk[l]+4*t;
+        v[l]=((unsign32)p[0]<<24)|((unsign32)p[1]<<16)|((unsign32)p[2]<<8)|(unsign32)p[3];
+    }
+    return _mm256_loadu_si256((const __m256i *)v);
+}
+
+/* One block for each of eight lanes, lanes with a zero mask keep their state */
+__attribute__((target("avx2")))
+static void MCL_HASH256_transform8(__m256i *s,const unsigned char *blk[8],__m256i mask)
+{
+    __m256i a,b,c,d,e,f,g,h,t1,t2;
+    __m256i w[16];
+    int j;
+
+    for (j=0;j<16;j++) w[j]=MCL_HASH256_gather8(blk,j);
+
+    a=s[0]; b=s[1]; c=s[2]; d=s[3];
+    e=s[4]; f=s[5]; g=s[6]; h=s[7];
+
+    for (j=0;j<64;j++)
+    {
+        if (j>=16)
+            w[j&15]=_mm256_add_epi32(_mm256_add_epi32(THETA1_8(w[(j-2)&15]),w[(j-7)&15]),
+                                     _mm256_add_epi32(THETA0_8(w[(j-15)&15]),w[j&15]));
+        t1=_mm256_add_epi32(_mm256_add_epi32(h,SIG1_8(e)),
+                            _mm256_add_epi32(CH8(e,f,g),_mm256_add_epi32(_mm256_set1_epi32((int)K_256[j]),w[j&15])));
+        t2=_mm256_add_epi32(SIG0_8(a),MAJ8(a,b,c));
+        h=g; g=f; f=e;
+        e=_mm256_add_epi32(d,t1);
+        d=c; c=b; b=a;
+        a=_mm256_add_epi32(t1,t2);
+    }
+
+    s[0]=_mm256_blendv_epi8(s[0],_mm256_add_epi32(s[0],a),mask);
+    s[1]=_mm256_blendv_epi8(s[1],_mm256_add_epi32(s[1],b),mask);
+    s[2]=_mm256_blendv_epi8(s[2],_mm256_add_epi32(s[2],c),mask);
+    s[3]=_mm256_blendv_epi8(s[3],_mm256_add_epi32(s[3],d),mask);
+    s[4]=_mm256_blendv_epi8(s[4],_mm256_add_epi32(s[4],e),mask);
+    s[5]=_mm256_blendv_epi8(s[5],_mm256_add_epi32(s[5],f),mask);
+    s[6]=_mm256_blendv_epi8(s[6],_mm256_add_epi32(s[6],g),mask);
+    s[7]=_mm256_blendv_epi8(s[7],_mm256_add_epi32(s[7],h),mask);
+}
+
+/* Hash n<=8 messages, one per lane. Each lane walks its own whole blocks
+   and then one or two padded tail blocks; lanes that finish early are masked */
+__attribute__((target("avx2")))
+void MCL_HASH256_multi_avx2(int n,const char *msg[],const int len[],char *digest)
+{
+    static const unsigned char zero[64]={0};
+    unsigned char pad[8][128];
+    const unsigned char *blk[8];
+    int full[8],total[8],lanes[8];
+    unsign32 out[8];
+    __m256i s[8];
+    int i,j,l,rem,maxb=0;
+    unsign64 bits;
+
+    for (l=0;l<8;l++)
+    {
+        if (l>=n)
+        { /* unused lane */
+            full[l]=total[l]=0;
+            continue;
+        }
+        full[l]=len[l]/64;
+        rem=len[l]%64;
+        total[l]=full[l]+((rem<56) ? 1 : 2);
+        for (i=0;i<128;i++) pad[l][i]=0;
+        for (i=0;i<rem;i++) pad[l][i]=(unsigned char)msg[l][64*full[l]+i];
+        pad[l][rem]=0x80;
+        bits=(unsign64)len[l]*8;
+        for (i=0;i<8;i++)
+            pad[l][64*(total[l]-full[l])-1-i]=(unsigned char)(bits>>(8*i));
+        if (total[l]>maxb) maxb=total[l];
+    }
+
+    for (i=0;i<8;i++) s[i]=_mm256_set1_epi32((int)H_256[i]);
+
+    for (j=0;j<maxb;j++)
+    {
+        for (l=0;l<8;l++)
+        {
+            lanes[l]=(j<total[l]) ? -1 : 0;
+            if (j<full[l]) blk[l]=(const unsigned char *)msg[l]+64*j;
+            else if (j<total[l]) blk[l]=pad[l]+64*(j-full[l]);
+            else blk[l]=zero;
+        }
+        MCL_HASH256_transform8(s,blk,_mm256_loadu_si256((const __m256i *)lanes));
+    }
+
+    for (i=0;i<8;i++)
+    { /* word i of every lane */
+        _mm256_storeu_si256((__m256i *)out,s[i]);
+        for (l=0;l<n;l++)
+        {
+            digest[32*l+4*i]=(char)(out[l]>>24);
+            digest[32*l+4*i+1]=(char)(out[l]>>16);
+            digest[32*l+4*i+2]=(char)(out[l]>>8);
+            digest[32*l+4*i+3]=(char)out[l];
+        }
+    }
+}
+
+#endif
@@ -125,8 +125,7 @@ void MCL_RAND_seed(csprng *rng,int rawlen,char *raw)
     if (rawlen>0)
     {
         MCL_HASH256_init(&sh);
-        for (i=0;i<rawlen;i++)
-            MCL_HASH256_process(&sh,raw[i]);
+        MCL_HASH256_process_array(&sh,raw,rawlen);
         MCL_HASH256_hash(&sh,digest);
 
 /* initialise PRNG from distilled randomness */
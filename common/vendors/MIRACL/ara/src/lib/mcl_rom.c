@@ -152,6 +152,40 @@ const mcl_chunk MCL_CURVE_B[MCL_NL]={0x135978A3,0xF5A6E50,0x10762ADD,0x149A82,0x
 const mcl_chunk MCL_CURVE_Order[MCL_NL]={0x1CF5D3ED,0x9318D2,0x1DE73596,0x1DF3BD45,0x14D,0x0,0x0,0x0,0x100000}; 
 const mcl_chunk MCL_CURVE_Gx[MCL_NL]={0xF25D51A,0xAB16B04,0x969ECB2,0x198EC12A,0xDC5C692,0x1118FEEB,0xFFB0293,0x1A79ADCA,0x216936};
 const mcl_chunk MCL_CURVE_Gy[MCL_NL]={0x6666658,0x13333333,0x19999999,0xCCCCCCC,0x6666666,0x13333333,0x19999999,0xCCCCCCC,0x666666};
+const mcl_chunk MCL_CURVE_GComb[2*MCL_COMB_POINTS*MCL_NL]={
+0x1BD040D8,0x1F7B3D5D,0xB0C3B8E,0x179FD82E,0xAA2D3E9,0x18923775,0x1FEFA1AC,0x1EBC492F,0x48C091,
+0x1057A890,0x1657D06A,0x575DE14,0x1F667297,0x16B489FC,0x1F792E95,0x1F8C18CE,0x7CF6C89,0xAEE76,
+0x2043F4E,0x1315DEBD,0x1116148E,0x17BD4B03,0x18CEBB5E,0xDEB13C0,0x1EAF2D18,0xD2C53C8,0x1BC8BF,
+0x5E85B1A,0x1C3341D1,0x13D65C4E,0xAA81DF5,0xDBED224,0x8298CB5,0x15CD86F1,0x1CB8F79C,0x17699B,
+0x1821F7C6,0x11DF007E,0x98D3ED9,0xBFF12B6,0x17CAB90E,0x1A8A7F43,0xEF17BB3,0x1D4ED175,0x69E504,
+0x1A4EB21F,0x70868C6,0x4B3E52C,0xE97D5A5,0x15E41D3E,0x82D938,0x9DD12EA,0x10D77890,0x255494,
+0x3ADDD5C,0x1CF5231B,0xD9A09D2,0x957D255,0x1E40F941,0x16E3BFF8,0x99D5B88,0x112011BD,0x1C99AB,
+0xAC7502D,0x138E9924,0x11B04781,0x1740083E,0x1D353085,0x13384206,0x1B7D6EA8,0xF77A269,0x3B35DD,
+0x10D653E4,0x15139D7C,0xC92AB7A,0x94D52E0,0x1B602BF6,0xDC08D5D,0x19F7E063,0x1BFC1D63,0x1DFECC,
+0x12559F20,0x1DDE59DF,0xDB3E24E,0xCA2F7A,0x1B1AC20,0x13F16DEF,0x1A97623F,0x1427CBAC,0x6B6FE3,
+0x16408F56,0x7AADBAD,0x531DA6D,0x14654854,0x12A46BE4,0x1152947E,0x17D849F3,0xDDF762B,0x1F9835,
+0x1C087F9,0x66D4B10,0x1C1E87,0x31A97BE,0x7129B0,0x1B58E71F,0x1D98EC5B,0x10222836,0x1AE941,
+0x1E07E6FE,0xC0FAA4C,0x15DCDF46,0x15F973FE,0x1776D5E4,0x49DEF3,0xEFE2A4F,0x140ABF18,0x7E0B9A,
+0x39A26FE,0x5B8140C,0xBBDF025,0x62EADD6,0xFB78794,0x39D81BC,0x1E91F646,0x7C00738,0x77AC1A,
+0x113BF6,0x749D708,0x1834366E,0x16B6B5A5,0xC087600,0xE9987D4,0x12ED8958,0x1797D1F9,0x34F98E,
+0x13BA9BA6,0x1134D5D7,0x128C1062,0xA4B9D25,0xAB84986,0x1BB40DE2,0x1492E472,0x156D1754,0x39F07F,
+0x3D6E983,0x1AF978BA,0x176D0F7A,0x3E00C46,0xFBFBC17,0x1B3A2888,0xB7D439E,0x2021F0A,0x244029,
+0x13E535F6,0x1211175D,0x10DA5DDD,0x141E2931,0x1C22779D,0x17C5BAF1,0x53EABDD,0x361678D,0x7BF5B7,
+0x122214D7,0x240FC73,0x1A1C8593,0x17D9A5BC,0xC50F454,0x11546214,0x3B4B21E,0x18E61C3C,0x4823A8,
+0x1FCDC162,0x115D0DE9,0x45BBD6C,0x3051EF9,0x1B9B5AE7,0x22FA8CC,0x149D9900,0x16E0BEEA,0x655B9A,
+0x8645615,0xA2688E7,0x194E4538,0x1778A177,0x1A52AC50,0x14CC1C23,0x792DFAD,0xB7586F3,0x2F5DB6,
+0x9344A35,0x5F168C6,0x16FED3DC,0x9054EFF,0xE698F0C,0x1ABC3F75,0x75ABC5C,0x279262B,0x76FE8E,
+0xD56969,0x124AB33D,0x12FAA9E6,0x15ABE67B,0x8155514,0xE4865A0,0x1893E9B2,0x109BFB56,0x38C1CB,
+0x383D364,0x1D722C5E,0xD1C1719,0x2BAECA7,0x18A46C77,0x14D1732,0x88AC268,0x1D197231,0x7E176F,
+0x10F24F49,0x1B4C67D0,0x91C0594,0x180531F5,0x1B57E350,0x1E51881B,0xAEA6FB,0x4472893,0x618980,
+0x8F6BC9C,0xDCB819F,0x1505135F,0xE7E27D4,0x109CE981,0x10073DC3,0x1B17EED8,0x17EE459D,0x78704E,
+0x1B6737F4,0xC650327,0xDA8B8D5,0x16E1F6D8,0x32A78DC,0x3AB13B1,0x18119D49,0xF6D4D87,0x1FE109,
+0x1FFE99A,0x18CF200C,0x55F4D42,0x44E9A9B,0x11A21E4D,0x1A172B85,0x99DC7D5,0x9E1314C,0x27BDE0,
+0x1B77BFC5,0x150E4410,0x42E0309,0x388B135,0x1D0DD58A,0x1BFE584D,0x14A91D9C,0x10334478,0xD1DEE,
+0x100BFE41,0x139BB003,0x843DE49,0x1D1D8551,0x1516ABDE,0x12EC7E32,0x19B6AADF,0x10889225,0x321919,
+0x9BDFBA7,0x4FB60AA,0x17F976EE,0x98BD4D3,0xF54C61D,0x1DB4BD33,0x1AD55D77,0x1E635EDE,0x8BE55,
+0x1AA0CC4D,0x2EF532D,0x15F976D6,0x54DB5BB,0xF81C74E,0x1D10F627,0xC83A2D7,0x180B01BF,0x5579D3
+};
 
 #endif
 
@@ -182,6 +216,40 @@ const mcl_chunk MCL_CURVE_B[MCL_NL]={0xEB4DCA135978A3,0xA4D4141D8AB75,0x797779E8
 const mcl_chunk MCL_CURVE_Order[MCL_NL]={0x12631A5CF5D3ED,0xF9DEA2F79CD658,0x14DE,0x0,0x10000000};
 const mcl_chunk MCL_CURVE_Gx[MCL_NL]={0x562D608F25D51A,0xC7609525A7B2C9,0x31FDD6DC5C692C,0xCD6E53FEC0A4E2,0x216936D3};
 const mcl_chunk MCL_CURVE_Gy[MCL_NL]={0x66666666666658,0x66666666666666,0x66666666666666,0x66666666666666,0x66666666};
+const mcl_chunk MCL_CURVE_GComb[2*MCL_COMB_POINTS*MCL_NL]={
+0xEF67ABBBD040D8,0xCFEC172C30EE3B,0x246EEAAA2D3E9B,0xE2497FFBE86B31,0x48C091F5,
+0xCAFA0D5057A890,0xB3394B95D77852,0xF25D2B6B489FCF,0x7B644FE30633BE,0xAEE763E,
+0x62BBD7A2043F4E,0xDEA581C458523A,0xD627818CEBB5EB,0x629E47ABCB461B,0x1BC8BF69,
+0x86683A25E85B1A,0x540EFACF59713B,0x53196ADBED2245,0xC7BCE57361BC50,0x17699BE5,
+0x3BE00FD821F7C6,0xFF895B2634FB66,0x14FE877CAB90E5,0x768BABBC5EECF5,0x69E504EA,
+0xE10D18DA4EB21F,0x4BEAD292CF94B0,0x5B2715E41D3E7,0xBBC4827744BA81,0x25549486,
+0x9EA46363ADDD5C,0xABE92AB668274B,0xC77FF1E40F9414,0x8DEA6756E22D,0x1C99AB89,
+0x71D3248AC7502D,0xA0041F46C11E06,0x70840DD353085B,0xBD134EDF5BAA26,0x3B35DD7B,
+0xA273AF90D653E4,0xA6A970324AADEA,0x811ABBB602BF64,0xE0EB1E7DF818DB,0x1DFECCDF,
+0xBBCB3BF2559F20,0x6517BD36CF893B,0xE2DBDE1B1AC200,0x3E5D66A5D88FE7,0x6B6FE3A1,
+0xF55B75B6408F56,0x32A42A14C769B4,0xA528FD2A46BE4A,0xFBB15DF6127CE2,0x1F98356E,
+0xCDA96201C087F9,0x8D4BDF00707A1C,0xB1CE3E07129B01,0x1141B7663B16F6,0x1AE94181,
+0x81F5499E07E6FE,0xFCB9FF57737D19,0x93BDE7776D5E4A,0x55F8C3BF8A93C0,0x7E0B9AA0,
+0xB70281839A26FE,0x1756EB2EF7C094,0x3B0378FB787943,0x39C7A47D9187,0x77AC1A3E,
+0xE93AE100113BF6,0x5B5AD2E0D0D9B8,0x330FA8C087600B,0xBE8FCCBB62561D,0x34F98EBC,
+0x269ABAF3BA9BA6,0x25CE92CA30418A,0x681BC4AB849865,0x68BAA524B91CB7,0x39F07FAB,
+0x5F2F1743D6E983,0xF006235DB43DEB,0x745110FBFBC171,0x10F852DF50E7B6,0x24402910,
+0x4222EBB3E535F6,0xF1498C3697776,0x8B75E3C22779DA,0xB3C694FAAF76F,0x7BF5B71B,
+0x481F8E722214D7,0xECD2DE6872164C,0xA8C428C50F454B,0x30E1E0ED2C87A2,0x4823A8C7,
+0x2BA1BD3FCDC162,0x828F7C916EF5B2,0x5F5199B9B5AE71,0x5F75527664004,0x655B9AB7,
+0x44D11CE8645615,0xBC50BBE53914E1,0x983847A52AC50B,0xAC3799E4B7EB69,0x2F5DB65B,
+0xBE2D18C9344A35,0x82A77FDBFB4F70,0x787EEAE698F0C4,0xC93159D6AF1735,0x76FE8E13,
+0x495667A0D56969,0xD5F33DCBEAA79A,0x90CB408155514A,0xDFDAB624FA6C9C,0x38C1CB84,
+0xAE458BC383D364,0x5D7653B4705C67,0x9A2E658A46C771,0xCB918A22B09A02,0x7E176FE8,
+0x698CFA10F24F49,0x298FAA4701653,0xA31037B57E350C,0x3944982BA9BEFC,0x61898022,
+0xB97033E8F6BC9C,0x3F13EA54144D7D,0xE7B8709CE9817,0x722CEEC5FBB620,0x78704EBF,
+0x8CA064FB6737F4,0x70FB6C36A2E355,0x56276232A78DCB,0x6A6C3E04675247,0x1FE1097B,
+0x19E40181FFE99A,0x274D4D957D350B,0x2E570B1A21E4D2,0x98A626771F574,0x27BDE04F,
+0xA1C8821B77BFC5,0xC4589A90B80C26,0xFCB09BD0DD58A1,0x9A23C52A476737,0xD1DEE81,
+0x737600700BFE41,0x8EC2A8A10F7926,0xD8FC65516ABDEE,0x44912E6DAAB7E5,0x32191984,
+0x9F6C1549BDFBA7,0xC5EA69DFE5DBB8,0x697A66F54C61D4,0x1AF6F6B5575DFB,0x8BE55F3,
+0x5DEA65BAA0CC4D,0xA6DADDD7E5DB58,0x21EC4EF81C74E2,0x580DFB20E8B5FA,0x5579D3C0
+};
 
 #endif
 
@@ -246,6 +314,40 @@ const mcl_chunk MCL_CURVE_Order[MCL_NL]={0x35844F3,0x7185255,0x63D548D,0x13946E2
 const mcl_chunk MCL_CURVE_B[MCL_NL]={0x7FF6756,0x7FFFFFF,0x7FFFFFF,0x7FFFFFF,0x7FFFFFF,0x7FFFFFF,0x7FFFFFF,0x7FFFFFF,0x7FFFEFF,0x7FFFFFF,0x7FFFFFF,0x7FFFFFF,0x7FFFFFF,0x7FFFFFF,0x7FFFFFF,0x7FFFFFF,0xFFFF};
 const mcl_chunk MCL_CURVE_Gx[MCL_NL]={0x5555555,0x2AAAAAA,0x5555555,0x2AAAAAA,0x5555555,0x2AAAAAA,0x5555555,0x2AAAAAA,0x2AAA955,0x5555555,0x2AAAAAA,0x5555555,0x2AAAAAA,0x5555555,0x2AAAAAA,0x5555555,0xAAAA};
 const mcl_chunk MCL_CURVE_Gy[MCL_NL]={0x29386ED,0x55F79BD,0x681AF6B,0x15F68E6,0x18BBBCB,0x6745461,0x3595960,0x6C625C0,0x36D728A,0x1BAF6FC,0x680D621,0x1B76B,0x5086C2B,0x6B3AC40,0x5C1236C,0x74B1A56,0xAE05};
+const mcl_chunk MCL_CURVE_GComb[2*MCL_COMB_POINTS*MCL_NL]={
+0x56E7A75,0x16A799F,0x64B0CF4,0x3F60004,0x23E6DE0,0x680379B,0x373784E,0x5358AF5,0x22F2D6F,0x759D8EC,0x4C7932,0x526F270,0x2190C20,0x105CD6C,0x4078A71,0x5127563,0xDF10,
+0x74F8EAB,0x118154F,0x708A7C7,0x71AB363,0x2D64A21,0x59FA905,0x7CFB0A3,0x346BFEA,0x377E5F,0x340B474,0x5616D89,0x7C98D1E,0x3C58AEF,0x4FB0BE4,0x1297407,0x4585EE,0x58D9,
+0x1C1973B,0x5B6EA06,0x33421D8,0x6176038,0x2FD9227,0x7E72229,0x695B2E6,0x9321A3,0x4D6E7E3,0x6670A4F,0x5136E8,0x257A36E,0x5FD8556,0x56EBF75,0x32CDB68,0x2F78ECA,0xE205,
+0x470731E,0x6D3CBDA,0x621C13,0x5EA18,0x336F8F0,0x6556170,0x7BF1900,0x4AC7C98,0x1DFF564,0x24DFC03,0x71F1762,0x204B0FB,0x394B8AD,0x51A53D,0x589C095,0x2F53409,0x944E,
+0x6390F33,0x369BB8D,0xC59E53,0x4A272E5,0x233CB,0x4843911,0x4833EAF,0x760DC15,0x6C535EE,0x9789FB,0x5259015,0x40A5870,0x3AF6348,0xEE7E21,0x6E55784,0x2CCBD58,0xF7D9,
+0x4CA88E1,0x589689A,0x624F5A2,0x3D3555A,0x7EA8DD5,0x21D50E5,0x7047272,0x2C2197E,0x5FF9092,0x3B5078B,0x1323FB3,0x4FC12AA,0x49CC87,0x61525A0,0x18134D6,0x6C9CC04,0x5202,
+0x392FCFA,0x69FB21F,0x354444A,0x307FFF0,0x3D880CC,0x5ECF574,0x726ECFF,0x14BD610,0x7AF4401,0x64987EB,0x578B1A7,0x1C93784,0x7202B47,0xA308C7,0x63FC88D,0x581DA59,0xAD4C,
+0x29117CA,0x2DCDDC4,0x364A41E,0x56396DC,0x1286742,0x7C6BD9E,0x19ACD37,0x4A05E3B,0x4357EB7,0xCF549,0x7FE9F09,0x23B3A18,0x35F6B44,0x52DC3F6,0x5565721,0x175FE1,0xAAF6,
+0x74B4197,0x579C3EA,0x1F6AC86,0x6733988,0x1DD2182,0x7418F93,0x18F84DD,0x6F64FD4,0x680B8A9,0x4C49C71,0x29011A3,0x7C6FC31,0x4A0BA4,0x24C97C6,0x6BE82F5,0x5F4FB06,0x443A,
+0xFCE2E9,0x5C9CD8F,0x3CE2F27,0xC45EAA,0x6704961,0x64A5D57,0x648895D,0x3C094F0,0x1B39596,0x248823A,0x2C7A422,0x613DFD1,0x30BCA45,0x609B709,0x2FF71D7,0x50D1A04,0xED81,
+0x370BB55,0x4A669A2,0x4AC5966,0x4E9B315,0xF80702,0x60546AD,0x495720C,0x7353F36,0x632719A,0x476BB5E,0xA23E13,0x75517F4,0x721AF2A,0x483402A,0x4F829E5,0x2952C06,0x55C7,
+0x28B204A,0x1FD03FD,0x2CC7313,0x9A6414,0x2A372B3,0x7089F3E,0x2521037,0x3982200,0x46396B8,0x2EB3964,0x41147A5,0x6A7AA76,0x798AB7D,0x2EF1BFC,0x323ADD9,0x17803EE,0x412D,
+0x6CCB872,0x15C7970,0x3182281,0x2071667,0x2F9FE1C,0x51EB44F,0x35DB11F,0x2C5C1E1,0x2C172A3,0x38FB6DB,0x5C8D5C8,0x6DF722B,0x20E5D23,0x3EC7968,0x5E71AFB,0x70D52C7,0x213,
+0x6FC9C77,0x31C9856,0x5FA75D5,0x4312434,0x62DA7AB,0x40D25B8,0x63E0B78,0x1FC3A98,0x6E0250C,0x7F9CF25,0x2669CFE,0x609A06,0x27A8A2B,0x409D028,0x1C309C,0x87BFBC,0xC994,
+0x4F44593,0x64BF81A,0x7C2AF8F,0x3CBD6FC,0xF617FA,0x63FD1E9,0x2EF827F,0x5A727E5,0x11D6C9D,0x4F95D7E,0x343B568,0x536C4F0,0x4CEA71B,0x3481F4A,0x7AD251F,0x1BB1D2E,0x3D41,
+0x2284CCA,0x207ACAD,0x131BA3E,0x6AE02C7,0x5D25A63,0x27650EF,0x1C2B60F,0x433514D,0x9BE84F,0x18751D1,0x11F81EF,0x18EC25B,0x1DE34D8,0x809E38,0x5F9566A,0x1806BA0,0x3224,
+0x6BC3F1E,0x26707BA,0x594024D,0x6C6B62B,0x4859A3E,0x72EB013,0x237996B,0x4FB9C7E,0xB7B82,0x6470BAD,0x2D5229F,0x4C90691,0x758F026,0x2396BD1,0x16FAC3D,0x688E0C,0x6278,
+0xF7F295,0xB7C30D,0x10566E4,0x4D58A01,0x66E7C0B,0x610DF0E,0x512ED8C,0x3104A7C,0x1A521D8,0x4A257CA,0x7C2A189,0x24A11E4,0x28896BF,0x44DDA22,0x402450F,0x3F120A4,0xAE1D,
+0x365BF33,0x49B43CF,0x79168C7,0x2F9DA18,0x487E5DD,0xD32F47,0x3CE0C46,0x305907F,0x6E6194,0x4C624B1,0x144507F,0x1012B8C,0x55D08E7,0xC607FD,0x7DF4E90,0x14E9ABC,0x16BE,
+0xD99948,0x5345A14,0x62DDFA1,0x31B6364,0x190D68,0x2FF6FF,0x68C67C8,0x1C8D0BF,0x6B68E28,0x53D027B,0x7ADA033,0x6D649F2,0x12D52E7,0x6B54AC,0x71EF31E,0x706361A,0x3AA3,
+0x6CAD37E,0x2BA8737,0x52A3412,0x570A34B,0xCDC75C,0x16BF2C9,0x4F76424,0x34F1ECE,0xA6A62B,0x3C4D966,0x41121BD,0x66B13A,0x10A6AB6,0x9B59D0,0x483D0BD,0x72B99E8,0xA11B,
+0x54862BF,0x50FB784,0x3CA9C03,0xF2D61A,0x2F5D864,0x2D76DD1,0x92E7DB,0x36D56C2,0xD82F7D,0x4B95194,0x61A178E,0x6C694A9,0x65678FF,0x162764E,0x38B2BD3,0x13ED852,0x3C67,
+0x564C388,0x7C11416,0x19740A6,0x38F7523,0x6534F51,0x1736FC7,0x21A181B,0x556EF31,0x72D6FFA,0x1DE82BA,0x628FCC,0x130AEB4,0x56347AB,0x340CBCA,0x4349B2F,0x69A51D4,0x9DAD,
+0x3532F93,0x7CD4A67,0x7B70B2C,0x699B022,0x6A54B95,0x32B9133,0xEEE47D,0x865D5F,0x4D556B7,0x424AF6,0x111B7EE,0x2631686,0x6DF3B03,0x3E08959,0x2A27D77,0x72BFAC2,0xE300,
+0x6A772B6,0x298C8C6,0x1656E75,0x6CE8A8A,0x3478B34,0x74AD5AA,0x2AF0126,0x70EF27A,0x48A002,0x77EA301,0x1A1CA90,0x4FD2A7B,0x1BD8725,0xA81296,0x2315034,0x182A208,0xFDB5,
+0x76FB4C9,0x60B7DAE,0x6D35BF9,0x764AB18,0x559454,0x223A481,0x154B9B2,0x2BB6B5C,0x7353620,0x4A57D0F,0x445668B,0x38F3886,0x2631806,0xFE473E,0x4B3CA58,0x62B1C4A,0xE4D4,
+0x25F5CA0,0x13E8C4C,0x2AF2084,0x2B22E60,0xB42956,0x6362AC0,0x65C1CC1,0x4E121FD,0x50EF6AC,0x1948820,0x4E25603,0x4A76680,0x34241C4,0x68CA23E,0x724DBA5,0x73F47A1,0xA53D,
+0x3738952,0x2B05AAC,0x1FAAD26,0x585702D,0x536FB37,0x513F288,0x1C1AC51,0x27B092B,0x63A3E4,0x39AB80C,0x4E7535C,0x4E4FF5C,0x4031C84,0x5683617,0x6021EC9,0x2FE1E75,0x953B,
+0x63127F9,0x1C192CA,0x2AA846A,0x5CC6F11,0x667B8EF,0x4382B88,0x613724F,0x54C1D6E,0x287D80F,0xFDA8AF,0x778A6B2,0x45BA240,0x7B9233,0x5F8526C,0x6B6643E,0x1FA7742,0x5373,
+0x36C6D20,0x58DCAC6,0x3B7F4AF,0x404709C,0x57021F0,0x4CDF4AC,0x48A384D,0x6F46827,0x7DE61DF,0x66382FB,0x26B79B4,0x4533D93,0x7FAE44B,0x71F132C,0x4B33310,0x1EEC565,0x1365,
+0x3795FF4,0x29D4705,0x4EA4455,0x348CAB7,0x186AC84,0x353B330,0x63DF7BC,0x6684216,0x2AE60FF,0x4F6A333,0x6114910,0x43A048B,0x3D81257,0x463F888,0x1702530,0x2BBE0B3,0x9697,
+0x4565BBF,0x26CC04,0x1916DF7,0x77084A1,0x4DFA9FC,0x65E36D1,0x6F192D2,0x4E31FCB,0x36D8796,0x3EB3E70,0x35B97BD,0x61093,0x7D3DAF9,0x16D1C1E,0x6BFFBF7,0x6C24E07,0x7FB4
+};
 #endif
 
 #if MCL_CHUNK==64
@@ -256,6 +358,40 @@ const mcl_chunk MCL_CURVE_Order[MCL_NL]={0x378C292AB5844F3,0x3309CA37163D548,0x1
 const mcl_chunk MCL_CURVE_B[MCL_NL]={0x3FFFFFFFFFF6756,0x3FFFFFFFFFFFFFF,0x3FFFFFFFFFFFFFF,0x3FBFFFFFFFFFFFF,0x3FFFFFFFFFFFFFF,0x3FFFFFFFFFFFFFF,0x3FFFFFFFFFFFFFF,0x3FFFFFFFFFF};
 const mcl_chunk MCL_CURVE_Gx[MCL_NL]={0x155555555555555,0x155555555555555,0x155555555555555,0x2A5555555555555,0x2AAAAAAAAAAAAAA,0x2AAAAAAAAAAAAAA,0x2AAAAAAAAAAAAAA,0x2AAAAAAAAAA};
 const mcl_chunk MCL_CURVE_Gy[MCL_NL]={0x2EAFBCDEA9386ED,0x32CAFB473681AF6,0x25833A2A3098BBB,0x1CA2B6312E03595,0x35884DD7B7E36D,0x21B0AC00DBB5E8,0x17048DB359D6205,0x2B817A58D2B};
+const mcl_chunk MCL_CURVE_GComb[2*MCL_COMB_POINTS*MCL_NL]={
+0x10B53CCFD6E7A75,0x381FB000264B0CF,0x213B401BCDA3E6D,0xB5BE9AC57AB737,0x31E4CBACEC7622F,0x64308293793804,0x301E29C482E6B62,0x37C42893AB1,
+0x1C8C0AA7F4F8EAB,0x878D59B1F08A7C,0x28ECFD482AD64A,0x1F97DA35FF57CFB,0x5B625A05A3A037,0x3162BBFE4C68F56,0x4A5D01E7D85F23,0x1636422C2F7,
+0x22DB75031C1973B,0x9F0BB01C33421D,0xB9BF39114AFD92,0x39F8C4990D1E95B,0x4DBA3338527CD6,0x3F615592BD1B705,0xCB36DA2B75FBAD,0x388157BC765,
+0xF69E5ED470731E,0x3C002F50C0621C1,0x24032AB0B8336F8,0x3D592563E4C7BF1,0x3C5D8926FE019DF,0x252E2B502587DF1,0x3627025428D29EB,0x251397A9A04,
+0xDB4DDC6E390F33,0x32E5139728C59E5,0x3ABE421C8880233,0xD7BBB06E0AC833,0x1640544BC4FDEC5,0x2BD8D22052C3852,0x1B955E10773F10B,0x3DF65665EAC,
+0xAC4B44D4CA88E1,0x355E9AAAD624F5A,0x9C90EA872FEA8D,0x24249610CBF7047,0x8FECDDA83C5DFF,0x127321E7E095513,0x604D35B0A92D00,0x1480B64E602,
+0x2B4FD90FB92FCFA,0x33183FFF8354444,0x33FEF67ABA3D880,0x11004A5EB08726E,0x22C69F24C3F5FAF,0x80AD1CE49BC257,0x38FF2234518463F,0x2B532C0ED2C,
+0x396E6EE229117CA,0x10AB1CB6E364A41,0x34DFE35ECF12867,0x1FADE502F1D99AC,0x3A7C24067AA4C35,0x17DAD111D9D0C7F,0x35595C8696E1FB3,0x2ABD80BAFF0,
+0x1ABCE1F574B4197,0x20B399CC41F6AC8,0x1377A0C7C99DD21,0x2E2A77B27EA18F8,0x468E624E38E80,0x1282E93E37E18A9,0x1AFA0BD5264BE30,0x110EAFA7D83,
+0x1EE4E6C78FCE2E9,0x184622F553CE2F2,0x2577252EABE7049,0x25659E04A786488,0x1E908924411D1B3,0x2F291709EFE8AC,0xBFDC75F04DB84B,0x3B606868D02,
+0x1A5334D1370BB55,0xA74D98ACAC596,0x83302A3568F807,0x1C66B9A9F9B4957,0x8F84E3B5DAF632,0x86BCABAA8BFA0A,0x13E0A79641A0157,0x1571D4A9603,
+0xCFE81FEA8B204A,0x2CC4D320A2CC731,0xDF844F9F2A372,0x25AE1CC11002521,0x51E95759CB2463,0x262ADF753D53B41,0xC8EB765778DFE7,0x104B4BC01F7,
+0x4AE3CB86CCB872,0x71038B33B18228,0x47E8F5A27AF9FE,0x1CA8D62E0F0B5DB,0x235721C7DB6DAC1,0x39748F6FB915DC,0x379C6BEDF63CB42,0x84F86A963,
+0x158E4C2B6FC9C77,0x2AE18921A5FA75D,0x2DE20692DC62DA7,0x9430FE1D4C63E0,0x1A73FBFCE792EE0,0x1EA28AC304D0326,0x70C27204E8142,0x3265043DFDE,
+0x3F25FC0D4F44593,0x3E9E5EB7E7C2AF8,0x9FF1FE8F48F617,0x1B276D393F2AEF8,0xED5A27CAEBF11D,0x33A9C6E9B627834,0x1EB4947DA40FA54,0xF504DD8E97,
+0x3903D656A284CCA,0x18F570163931BA3,0x183D3B2877DD25A,0x3A13E19A8A69C2B,0x3E07BCC3A8E889B,0x378D360C7612D91,0x17E559A8404F1C1,0xC890C035D0,
+0x353383DD6BC3F1E,0xFB635B15D94024,0x25AF975809C859A,0x1EE0A7DCE3F2379,0x148A7F2385D680B,0x163C09A648348AD,0x5BEB0F51CB5E8F,0x189E0344706,
+0x105BE1868F7F295,0x2E6AC50090566E,0x3633086F8766E7C,0x876188253E512E,0xA8626512BE51A5,0x2225AFD2508F27C,0x1009143E26ED112,0x2B875F89052,
+0x1E4DA1E7B65BF33,0x3757CED0C79168C,0x31186997A3C87E5,0x1865182C83FBCE0,0x1141FE63125886E,0x174239C8095C614,0x1F7D3A406303FED,0x5AF8A74D5E,
+0x69A2D0A0D99948,0x1A18DB1B262DDFA,0x1F2017FB7F8190D,0x238A0E4685FE8C6,0x3680CE9E813DEB6,0xB54B9F6B24F97A,0x1C7BCC7835AA561,0xEA8F831B0D,
+0x95D439BECAD37E,0x172B851A5D2A341,0x1090B5F9648CDC7,0x298ADA78F674F76,0x486F5E26CB30A6,0x29AAD833589D41,0x120F42F44DACE81,0x2846F95CCF4,
+0xE87DBC254862BF,0x190796B0D3CA9C0,0x1F6D6BB6E8AF5D8,0xBDF5B6AB61092E,0x285E3A5CA8CA0D8,0x159E3FF634A54E1,0xE2CAF4CB13B276,0xF19C9F6C29,
+0x1BE08A0B564C388,0x145C7BA9199740A,0x206CB9B7E3E534F,0x1BFEAAB7798A1A1,0xA3F30EF415D72D,0x18D1EAC98575A06,0x10D26CBDA065E55,0x276B74D28EA,
+0x33E6A533B532F93,0x2574CD8117B70B2,0x11F595C899EA54B,0x15ADC432EAF8EEE,0x6DFB821257B4D5,0x37CEC0D318B4311,0xA89F5DDF044ACE,0x38C0395FD61,
+0x154C64636A772B6,0xD36745451656E7,0x49BA56AD53478B,0x2800B87793D2AF0,0x72A43BF5180848,0x2F61C967E953D9A,0x8C540D054094B1,0x3F6D4C15104,
+0x2705BED776FB4C9,0x153B2558C6D35BF,0x26C911D24085594,0xD8815DB5AE154B,0x159A2E52BE87F35,0x18C6019C79C4344,0x12CF29607F239F2,0x39353158E25,
+0x109F462625F5CA0,0x1595917302AF208,0x33071B15600B429,0x3DAB27090FEE5C1,0x9580CCA441050E,0x109071253B3404E,0x3C936E9746511F3,0x294F79FA3D0,
+0x19582D563738952,0xDEC2B8169FAAD2,0x314689F944536FB,0x28F913D84959C1A,0x1D4D71CD5C06063,0xC7212727FAE4E,0x38087B26B41B0BC,0x254ED7F0F3A,
+0x28E0C96563127F9,0x3BEE63788AAA846,0x93E1C15C4667B8,0x3603EA60EB76137,0x229AC87ED457A87,0x1EE48CE2DD12077,0x1AD990FAFC29360,0x14DCCFD3BA1,
+0x3EC6E56336C6D20,0x3C202384E3B7F4A,0x213666FA5657021,0x1877F7A3413C8A3,0x2DE6D331C17DFDE,0x3EB912E299EC9A6,0x32CCCC438F89967,0x4D94F762B2,
+0x154EA382B795FF4,0x211A4655BCEA445,0x1EF1A9D998186AC,0x183FF34210B63DF,0x524427B5199AAE,0x360495E1D0245E1,0x25C094C231FC443,0x25A5D5DF059,
+0x1C1366024565BBF,0x3F3B842509916DF,0xB4B2F1B68CDFA9,0x21E5A718FE5EF19,0x2E5EF5F59F3836D,0x34F6BE4030849B5,0x3AFFEFDCB68E0F7,0x1FED3612703
+};
 #endif
 
 #else
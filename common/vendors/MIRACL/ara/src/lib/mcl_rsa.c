@@ -43,13 +43,33 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
 /* RSA Functions - see main program below */
 
 #include "mcl_rsa.h"
+#ifdef MCL_RSA_THREADS
+#include <pthread.h>
+#endif
 
 #define ROUNDUP(a,b) ((a)-1)/(b)+1
 
+/* add an array of bytes to whichever hash is selected */
+static void hash_array(int sha,mcl_hash256 *sha256,mcl_hash512 *sha512,char *b,int len)
+{
+	switch(sha)
+	{
+	case MCL_SHA1:
+		MCL_HASH160_process_array(sha256,b,len); break;
+	case MCL_SHA256:
+		MCL_HASH256_process_array(sha256,b,len); break;
+	case MCL_SHA384:
+		MCL_HASH384_process_array(sha512,b,len); break;
+	case MCL_SHA512:
+		MCL_HASH512_process_array(sha512,b,len); break;
+	}
+}
+
 /* general purpose hash function w=hash(p|n|x|y) */
 static int hashit(int sha,mcl_octet *p,int n,mcl_octet *w)
 {
-    int i,c[4],hlen;
+    int i,hlen;
+    char c[4];
     mcl_hash256 sha256;
 	mcl_hash512 sha512;
     char hh[64];
@@ -68,40 +88,14 @@ static int hashit(int sha,mcl_octet *p,int n,mcl_octet *w)
     
 	hlen=sha;
 
-    if (p!=NULL) for (i=0;i<p->len;i++)
-	{	
-		switch(sha)
-		{
-		case MCL_SHA1:
-			MCL_HASH160_process(&sha256,p->val[i]); break;
-		case MCL_SHA256:
-			MCL_HASH256_process(&sha256,p->val[i]); break;
-		case MCL_SHA384:
-			MCL_HASH384_process(&sha512,p->val[i]); break;
-		case MCL_SHA512:
-			MCL_HASH512_process(&sha512,p->val[i]); break;
-		}
-	}
+    if (p!=NULL) hash_array(sha,&sha256,&sha512,p->val,p->len);
 	if (n>=0)
     {
         c[0]=(n>>24)&0xff;
         c[1]=(n>>16)&0xff;
         c[2]=(n>>8)&0xff;
         c[3]=(n)&0xff;
-		for (i=0;i<4;i++)
-		{
-			switch(sha)
-			{
-			case MCL_SHA1:
-				MCL_HASH160_process(&sha256,c[i]); break;
-			case MCL_SHA256:
-				MCL_HASH256_process(&sha256,c[i]); break;
-			case MCL_SHA384:
-				MCL_HASH384_process(&sha512,c[i]); break;
-			case MCL_SHA512:
-				MCL_HASH512_process(&sha512,c[i]); break;
-			}
-		}
+		hash_array(sha,&sha256,&sha512,c,4);
     }
 	  
 	switch (sha)
@@ -368,6 +362,113 @@ void MCL_RSA_ENCRYPT(MCL_rsa_public_key *PUB,mcl_octet *F,mcl_octet *G)
 	MCL_FF_toOctet(G,f,MCL_FFLEN);
 }
 
+/* check one signature S against the expected encoding W */
+static int RSA_verify(MCL_rsa_public_key *PUB,MCL_ff_mont *M,mcl_octet *S,mcl_octet *W)
+{
+	mcl_chunk s[MCL_FFLEN][MCL_BS],w[MCL_FFLEN][MCL_BS];
+	if (S->len!=MCL_RFS || W->len!=MCL_RFS) return 0;
+
+	MCL_FF_fromOctet(s,S,MCL_FFLEN);
+	if (MCL_FF_comp(s,PUB->n,MCL_FFLEN)>=0) return 0;
+
+	MCL_FF_mont_power(s,s,PUB->e,M);
+
+	MCL_FF_fromOctet(w,W,MCL_FFLEN);
+	return (MCL_FF_comp(s,w,MCL_FFLEN)==0);
+}
+
+/* RSA verification of a batch of signatures with the public key */
+int MCL_RSA_VERIFY_BATCH(MCL_rsa_public_key *PUB,mcl_octet *S[],mcl_octet *W[],int ok[],int num)
+{
+	int i,good=0;
+	MCL_ff_mont M;
+	MCL_FF_mont_init(&M,PUB->n,MCL_FFLEN);
+
+	for (i=0;i<num;i++)
+	{
+		ok[i]=RSA_verify(PUB,&M,S[i],W[i]);
+		good+=ok[i];
+	}
+	return good;
+}
+
+#ifdef MCL_RSA_THREADS
+
+#define RSA_BATCH_CHUNK 4 /* signatures claimed by a thread at a time */
+
+/* work shared by the threads of MCL_RSA_VERIFY_BATCH_MT */
+typedef struct
+{
+	MCL_rsa_public_key *PUB;
+	MCL_ff_mont *M;
+	mcl_octet **S,**W;
+	int *ok;
+	int num;
+	int next;  /* first signature not yet claimed */
+	int good;
+	pthread_mutex_t lock;
+} rsa_batch;
+
+static void *RSA_verify_worker(void *arg)
+{
+	rsa_batch *B=(rsa_batch *)arg;
+	int i,first,last,good=0;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&B->lock);
+		first=B->next;
+		last=first+RSA_BATCH_CHUNK;
+		if (last>B->num) last=B->num;
+		B->next=last;
+		pthread_mutex_unlock(&B->lock);
+		if (first>=last) break;
+
+		for (i=first;i<last;i++)
+		{
+			B->ok[i]=RSA_verify(B->PUB,B->M,B->S[i],B->W[i]);
+			good+=B->ok[i];
+		}
+	}
+
+	pthread_mutex_lock(&B->lock);
+	B->good+=good;
+	pthread_mutex_unlock(&B->lock);
+	return NULL;
+}
+
+/* as MCL_RSA_VERIFY_BATCH, the caller and threads-1 workers share one context */
+int MCL_RSA_VERIFY_BATCH_MT(MCL_rsa_public_key *PUB,mcl_octet *S[],mcl_octet *W[],int ok[],int num,int threads)
+{
+	int i,started=0;
+	pthread_t tid[MCL_RSA_MAX_THREADS];
+	MCL_ff_mont M;
+	rsa_batch B;
+
+	if (threads>MCL_RSA_MAX_THREADS) threads=MCL_RSA_MAX_THREADS;
+	if (threads<=1 || num<=RSA_BATCH_CHUNK) return MCL_RSA_VERIFY_BATCH(PUB,S,W,ok,num);
+
+	MCL_FF_mont_init(&M,PUB->n,MCL_FFLEN);
+	B.PUB=PUB; B.M=&M;
+	B.S=S; B.W=W; B.ok=ok;
+	B.num=num; B.next=0; B.good=0;
+	if (pthread_mutex_init(&B.lock,NULL)!=0) return MCL_RSA_VERIFY_BATCH(PUB,S,W,ok,num);
+
+	for (i=1;i<threads;i++)
+	{
+		if (pthread_create(&tid[started],NULL,RSA_verify_worker,&B)!=0) break;
+		started++;
+	}
+	RSA_verify_worker(&B);
+
+	for (i=0;i<started;i++)
+		pthread_join(tid[i],NULL);
+	pthread_mutex_destroy(&B.lock);
+	return B.good;
+}
+
+#endif
+
 /* RSA decryption with the private key */
 void MCL_RSA_DECRYPT(MCL_rsa_private_key *PRIV,mcl_octet *G,mcl_octet *F)
 {
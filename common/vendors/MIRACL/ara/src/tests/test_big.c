@@ -0,0 +1,183 @@
+/*************************************************************************
+                                                                         *
+Copyright (c) 2015>, MIRACL Ltd                                          *
+All rights reserved.                                                     *
+                                                                         *
+This file is derived from the MIRACL for Ara SDK.                        *
+                                                                         *
+The MIRACL for Ara SDK provides developers with an                       *
+extensive and efficient set of cryptographic functions.                  *
+For further information about its features and functionalities           *
+please refer to https://www.miracl.com                                   *
+                                                                         *
+Redistribution and use in source and binary forms, with or without       *
+modification, are permitted provided that the following conditions are   *
+met:                                                                     *
+                                                                         *
+ 1. Redistributions of source code must retain the above copyright       *
+    notice, this list of conditions and the following disclaimer.        *
+                                                                         *
+ 2. Redistributions in binary form must reproduce the above copyright    *
+    notice, this list of conditions and the following disclaimer in the  *
+    documentation and/or other materials provided with the distribution. *
+                                                                         *
+ 3. Neither the name of the copyright holder nor the names of its        *
+    contributors may be used to endorse or promote products derived      *
+    from this software without specific prior written permission.        *
+                                                                         *
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS  *
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED    *
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A          *
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT       *
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,   *
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED *
+TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR   *
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF   *
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     *
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS       *
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
+                                                                         *
+**************************************************************************/
+
+/* test driver for MCL_BIG multiplication and squaring */
+
+ 
+#include "mcl_arch.h"
+#include "mcl_config.h"
+#include "mcl_big.h"
+#include "mcl_utils.h"
+
+#define MCL_NLEN (1+((MCL_MBITS-1)/MCL_BASEBITS))	/**< Number of words in MCL_BIG. */
+#define DMCL_BS (2*MCL_BS)	/**< Number of words in DMCL_BIG. */
+
+#define TRIALS 1000
+
+/* schoolbook c=a*b one digit at a time, for normalised a and b */
+static void ref_mul(DMCL_BIG c,MCL_BIG a,MCL_BIG b)
+{
+  int i,j;
+  mcl_chunk carry;
+  MCL_BIG_dzero(c);
+  for (i=0;i<MCL_NLEN;i++)
+  {
+    carry=0;
+    for (j=0;j<MCL_NLEN;j++)
+      carry=MCL_muladd(a[i],b[j],carry,&c[i+j]);
+    c[MCL_NLEN+i]=carry;
+  }
+}
+
+/* check MCL_BIG_mul(a,b) and MCL_BIG_sqr(a) against the schoolbook product */
+static int check(MCL_BIG a,MCL_BIG b)
+{
+  int rc=0;
+  mcl_chunk x[MCL_BS],y[MCL_BS];
+  mcl_chunk want[DMCL_BS],got[DMCL_BS];
+
+  MCL_BIG_copy(x,a); MCL_BIG_norm(x);
+  MCL_BIG_copy(y,b); MCL_BIG_norm(y);
+
+  ref_mul(want,x,y);
+  MCL_BIG_copy(x,a); MCL_BIG_copy(y,b);
+  MCL_BIG_mul(got,x,y);
+  if (MCL_BIG_dcomp(want,got)!=0) rc++;
+
+  MCL_BIG_copy(x,a); MCL_BIG_norm(x);
+  ref_mul(want,x,x);
+  MCL_BIG_copy(x,a);
+  MCL_BIG_sqr(got,x);
+  if (MCL_BIG_dcomp(want,got)!=0) rc++;
+
+  if (rc)
+  {
+    printf("ERROR a= "); MCL_BIG_output(a);
+    printf("\r\n      b= "); MCL_BIG_output(b);
+    printf("\r\n");
+  }
+  return rc;
+}
+
+static void test()
+{
+  int i,j,rc=0;
+  char seed[32];
+  csprng RNG;
+  mcl_chunk a[MCL_BS],b[MCL_BS],s[MCL_BS],t[MCL_BS];
+
+  for (i=0;i<32;i++) seed[i]=(char)i;
+  MCL_RAND_seed(&RNG,32,seed);
+
+  /* zero, one and all digits full */
+  MCL_BIG_zero(a); MCL_BIG_one(b);
+  rc+=check(a,b);
+  rc+=check(b,b);
+  for (i=0;i<MCL_NLEN;i++) a[i]=((mcl_chunk)1<<MCL_BASEBITS)-1;
+  rc+=check(a,a);
+  rc+=check(a,b);
+
+  for (i=0;i<TRIALS;i++)
+  {
+    MCL_BIG_random(a,&RNG);
+    MCL_BIG_random(b,&RNG);
+    rc+=check(a,b);
+
+    /* unnormalised sums with a few bits of excess in the top digit */
+    MCL_BIG_copy(s,a); MCL_BIG_copy(t,b);
+    for (j=0;j<i%8;j++)
+    {
+      MCL_BIG_add(s,s,a);
+      MCL_BIG_add(t,t,b);
+    }
+    rc+=check(s,t);
+  }
+
+  printf("MCL_BIG_mul and MCL_BIG_sqr against schoolbook: %s\r\n", rc ? "FAILED" : "OK");
+  MCL_RAND_clean(&RNG);
+}
+
+#ifdef MCL_BUILD_ARM
+/* Thread handle */
+static os_thread_t test_thread;
+/* Buffer to be used as stack */
+static os_thread_stack_define(test_stack, 8 * 1024);
+
+/* create shadow yield thread */
+static int create_test_thread()
+{
+	int ret;
+	ret = os_thread_create(
+		/* thread handle */
+		&test_thread,
+		/* thread name */
+		"test",
+		/* entry function */
+		test,
+		/* argument */
+		0,
+		/* stack */
+		&test_stack,
+		/* priority */
+		OS_PRIO_3);
+	if (ret != WM_SUCCESS) {
+		wmprintf("Failed to create shadow yield thread: %d\r\n", ret);
+		return -WM_FAIL;
+	}
+	return WM_SUCCESS;
+}
+#endif
+
+int main()
+{   
+#ifdef MCL_BUILD_ARM
+  /* Initialize console on uart0 */
+  wmstdio_init(UART0_ID, 0);
+#endif
+
+#ifdef MCL_BUILD_ARM
+  create_test_thread();
+#else
+  test();
+#endif
+
+  return 0;
+}
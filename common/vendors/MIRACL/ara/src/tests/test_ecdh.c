@@ -44,6 +44,141 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
 #include "mcl_ecdh.h"
 #include "mcl_utils.h"
 
+/* RFC 4231 / RFC 7914 vectors, one-shot and streamed through a reused context */
+static void test_hmac()
+{
+  int i,j;
+  char *jefe="Jefe";
+  char *msg="what do ya want for nothing?";
+  char *lmsg="Test Using Larger Than Block-Size Key - Hash Key First";
+  char k[131],t[64],hex[129];
+  mcl_octet K={0,sizeof(k),k};
+  mcl_octet M={0,0,NULL};
+  mcl_octet T={0,sizeof(t),t};
+  mcl_hmac H;
+  int chunks[]={1,5,64};
+
+  printf("Testing HMAC\r\n");
+  MCL_OCT_jstring(&K,jefe);
+  M.val=msg; M.len=M.max=strlen(msg);
+
+  MCL_HMAC(MCL_SHA256,&M,&K,32,&T);
+  MCL_bin2hex(T.val,hex,T.len);
+  if (strcmp(hex,"5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"))
+    printf("*** HMAC-SHA256 Failed\r\n");
+
+  MCL_HMAC(MCL_SHA512,&M,&K,64,&T);
+  MCL_bin2hex(T.val,hex,T.len);
+  if (strcmp(hex,"164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+                 "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737"))
+    printf("*** HMAC-SHA512 Failed\r\n");
+
+  /* one keyed context, message fed in pieces, several times over */
+  MCL_HMAC_init(&H,MCL_SHA256,&K);
+  for (i=0;i<3;i++)
+  {
+    for (j=0;j<M.len;j+=chunks[i])
+      MCL_HMAC_update(&H,msg+j,(M.len-j<chunks[i])?M.len-j:chunks[i]);
+    MCL_HMAC_final(&H,32,&T);
+    MCL_bin2hex(T.val,hex,T.len);
+    if (strcmp(hex,"5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"))
+      printf("*** Streamed HMAC-SHA256 Failed, chunk %d\r\n",chunks[i]);
+  }
+  MCL_HMAC_kill(&H);
+
+  /* key longer than the block is hashed first */
+  MCL_OCT_empty(&K);
+  MCL_OCT_jbyte(&K,0xaa,131);
+  M.val=lmsg; M.len=M.max=strlen(lmsg);
+  MCL_HMAC(MCL_SHA256,&M,&K,32,&T);
+  MCL_bin2hex(T.val,hex,T.len);
+  if (strcmp(hex,"60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"))
+    printf("*** HMAC-SHA256 long key Failed\r\n");
+
+  /* PBKDF2-HMAC-SHA256, "passwd"/"salt", 1 iteration */
+  MCL_OCT_empty(&K);
+  MCL_OCT_jstring(&K,"passwd");
+  M.val="salt"; M.len=M.max=4;
+  MCL_PBKDF2(MCL_SHA256,&K,&M,1,32,&T);
+  MCL_bin2hex(T.val,hex,T.len);
+  if (strcmp(hex,"55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"))
+    printf("*** PBKDF2 Failed\r\n");
+
+  /* "password"/"salt", 4096 iterations */
+  MCL_OCT_empty(&K);
+  MCL_OCT_jstring(&K,"password");
+  MCL_PBKDF2(MCL_SHA256,&K,&M,4096,32,&T);
+  MCL_bin2hex(T.val,hex,T.len);
+  if (strcmp(hex,"c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a"))
+    printf("*** PBKDF2 4096 Failed\r\n");
+  else
+    printf("HMAC and PBKDF2 succeeded\r\n");
+}
+
+#if MCL_CHOICE==MCL_C25519
+/* RFC 7748 section 5.2 and 6.1 vectors */
+static void test_x25519()
+{
+  int i,rc=0;
+  char *vec[][3]={
+    {"a546e36bf0527c9d3b16154b82465edd62144c0ac1fc5a18506a2244ba449ac4",
+     "e6db6867583030db3594c1a424b15f7c726624ec26b3353b10a903a6d0ab1c4c",
+     "c3da55379de9c6908e94ea4df28d084f32eccf03491c71f754b4075577a28552"},
+    {"4b66e9d4d1b4673c5ad22691957d6af5c11b6421e0ea01d42ca4169e7918ba0d",
+     "e5210f12786811d3f4b7959d0538ae2c31dbe7106fc03c3efc4cd549c715a493",
+     "95cbde9476e8907d7aade45cb4b873f88b595a68799fa152e6f8f7647aac7957"},
+    {"0900000000000000000000000000000000000000000000000000000000000000",
+     "0900000000000000000000000000000000000000000000000000000000000000",
+     "422c8e7a6227d7bca1350b3e2bb7279f7897b87bb6854b783c60e80311ae3079"}};
+  char s[MCL_X25519_BYTES],u[MCL_X25519_BYTES],k[MCL_X25519_BYTES],w[MCL_X25519_BYTES],hex[2*MCL_X25519_BYTES+1];
+  mcl_octet S={MCL_X25519_BYTES,sizeof(s),s};
+  mcl_octet U={MCL_X25519_BYTES,sizeof(u),u};
+  mcl_octet K={0,sizeof(k),k};
+  mcl_octet W={0,sizeof(w),w};
+
+  printf("Testing X25519\r\n");
+  for (i=0;i<3;i++)
+  {
+    MCL_hex2bin(vec[i][0],s,64);
+    MCL_hex2bin(vec[i][1],u,64);
+    MCL_X25519(&S,&U,&K);
+    MCL_bin2hex(K.val,hex,K.len);
+    if (strcmp(hex,vec[i][2]))
+    {
+      printf("*** X25519 vector %d Failed\r\n",i);
+      rc=1;
+    }
+  }
+
+  /* Alice and Bob */
+  MCL_hex2bin("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a",s,64);
+  MCL_X25519_KEY_PAIR_GENERATE(NULL,&S,&W);
+  MCL_bin2hex(W.val,hex,W.len);
+  if (strcmp(hex,"8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a"))
+  {
+    printf("*** X25519 Alice public key Failed\r\n");
+    rc=1;
+  }
+  MCL_hex2bin("5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb",s,64);
+  MCL_X25519(&S,&W,&K);
+  MCL_bin2hex(K.val,hex,K.len);
+  if (strcmp(hex,"4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742"))
+  {
+    printf("*** X25519 shared secret Failed\r\n");
+    rc=1;
+  }
+
+  /* low order point gives the all-zero secret */
+  MCL_OCT_empty(&U); MCL_OCT_jbyte(&U,0,MCL_X25519_BYTES);
+  if (MCL_X25519(&S,&U,&K)!=MCL_ECDH_ERROR)
+  {
+    printf("*** X25519 zero point Failed\r\n");
+    rc=1;
+  }
+  if (!rc) printf("X25519 succeeded\r\n");
+}
+#endif
+
 static void test()
 {
   int res,i;
@@ -69,6 +204,11 @@ static void test()
   mcl_octet DS={0,sizeof(ds),ds};
   csprng RNG;                
 
+  test_hmac();
+#if MCL_CHOICE==MCL_C25519
+  test_x25519();
+#endif
+
   /* fake random seed source */
   char* seedHex = "d50f4137faff934edfa309c110522f6f5c0ccb0d64e5bf4bf8ef79d1fe21031a";
   MCL_hex2bin(seedHex, SEED.val, 64);
@@ -0,0 +1,259 @@
+/*************************************************************************
+                                                                         *
+Copyright (c) 2015>, MIRACL Ltd                                          *
+All rights reserved.                                                     *
+                                                                         *
+This file is derived from the MIRACL for Ara SDK.                        *
+                                                                         *
+The MIRACL for Ara SDK provides developers with an                       *
+extensive and efficient set of cryptographic functions.                  *
+For further information about its features and functionalities           *
+please refer to https://www.miracl.com                                   *
+                                                                         *
+Redistribution and use in source and binary forms, with or without       *
+modification, are permitted provided that the following conditions are   *
+met:                                                                     *
+                                                                         *
+ 1. Redistributions of source code must retain the above copyright       *
+    notice, this list of conditions and the following disclaimer.        *
+                                                                         *
+ 2. Redistributions in binary form must reproduce the above copyright    *
+    notice, this list of conditions and the following disclaimer in the  *
+    documentation and/or other materials provided with the distribution. *
+                                                                         *
+ 3. Neither the name of the copyright holder nor the names of its        *
+    contributors may be used to endorse or promote products derived      *
+    from this software without specific prior written permission.        *
+                                                                         *
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS  *
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED    *
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A          *
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT       *
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,   *
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED *
+TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR   *
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF   *
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     *
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS       *
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
+                                                                         *
+**************************************************************************/
+
+/* test driver for fixed-base multiplication of the curve generator, and double multiplication */
+/* Run with -t on the host to print the comb table for rom.c */
+
+
+#include <string.h>
+#include "mcl_arch.h"
+#include "mcl_config.h"
+#include "mcl_big.h"
+#include "mcl_fp.h"
+#include "mcl_ecp.h"
+#include "mcl_utils.h"
+
+#define MCL_NLEN (1+((MCL_MBITS-1)/MCL_BASEBITS))	/**< Number of words in MCL_BIG. */
+
+#define TRIALS 200
+
+#ifdef MCL_COMB_ORDERBITS
+
+static void output_coord(MCL_BIG a,int last)
+{
+  int i;
+  mcl_chunk t[MCL_BS];
+  MCL_BIG_copy(t,a);
+  MCL_FP_redc(t);
+  for (i=0;i<MCL_NLEN;i++)
+    printf("0x%llX%s",(unsigned long long)t[i],(last && i==MCL_NLEN-1) ? "" : ",");
+  printf("\n");
+}
+
+/* print the comb table in the form used by rom.c */
+static void output_table()
+{
+  int i;
+  MCL_ECP T[MCL_COMB_POINTS];
+  MCL_ECP_gen_comb(T);
+  printf("const mcl_chunk MCL_CURVE_GComb[2*MCL_COMB_POINTS*MCL_NL]={\n");
+  for (i=0;i<MCL_COMB_POINTS;i++)
+  {
+    output_coord(T[i].x,0);
+    output_coord(T[i].y,i==MCL_COMB_POINTS-1);
+  }
+  printf("};\n");
+}
+
+/* check the table in ROM matches the generator */
+static int check_table()
+{
+  int i,j,rc=0;
+  mcl_chunk x[MCL_BS],y[MCL_BS];
+  MCL_ECP T[MCL_COMB_POINTS];
+  MCL_ECP_gen_comb(T);
+  for (i=0;i<MCL_COMB_POINTS;i++)
+  {
+    MCL_BIG_copy(x,T[i].x); MCL_FP_redc(x);
+    MCL_BIG_copy(y,T[i].y); MCL_FP_redc(y);
+    for (j=0;j<MCL_NLEN;j++)
+    {
+      if (x[j]!=MCL_CURVE_GComb[2*i*MCL_NLEN+j]) rc=1;
+      if (y[j]!=MCL_CURVE_GComb[(2*i+1)*MCL_NLEN+j]) rc=1;
+    }
+  }
+  printf("MCL_CURVE_GComb against MCL_ECP_gen_comb: %s\r\n", rc ? "FAILED" : "OK");
+  return rc;
+}
+
+#endif
+
+/* check MCL_ECP_mul_gen(e) against MCL_ECP_mul(G,e) */
+static int check(MCL_BIG e)
+{
+  mcl_chunk gx[MCL_BS];
+  MCL_ECP P,Q;
+#if MCL_CURVETYPE!=MCL_MONTGOMERY
+  mcl_chunk gy[MCL_BS];
+  MCL_BIG_rcopy(gx,MCL_CURVE_Gx);
+  MCL_BIG_rcopy(gy,MCL_CURVE_Gy);
+  MCL_ECP_set(&Q,gx,gy);
+#else
+  MCL_BIG_rcopy(gx,MCL_CURVE_Gx);
+  MCL_ECP_set(&Q,gx);
+#endif
+  MCL_ECP_mul(&Q,e);
+  MCL_ECP_mul_gen(&P,e);
+  if (MCL_ECP_equals(&P,&Q)) return 0;
+  printf("ERROR e= "); MCL_BIG_output(e);
+  printf("\r\n");
+  return 1;
+}
+
+#if MCL_CURVETYPE!=MCL_MONTGOMERY
+/* check MCL_ECP_mul2_vartime(P,Q,e,f) against MCL_ECP_mul2(P,Q,e,f) */
+static int check2(MCL_ECP *P,MCL_ECP *Q,MCL_BIG e,MCL_BIG f)
+{
+  MCL_ECP A,B,C,D;
+  MCL_ECP_copy(&A,P); MCL_ECP_copy(&B,Q);
+  MCL_ECP_mul2(&A,&B,e,f);
+  MCL_ECP_copy(&C,P); MCL_ECP_copy(&D,Q);
+  MCL_ECP_mul2_vartime(&C,&D,e,f);
+  if (MCL_ECP_equals(&A,&C)) return 0;
+  printf("ERROR e= "); MCL_BIG_output(e);
+  printf("\r\n      f= "); MCL_BIG_output(f);
+  printf("\r\n");
+  return 1;
+}
+#endif
+
+static void test()
+{
+  int i,rc=0;
+  char seed[32];
+  csprng RNG;
+  mcl_chunk e[MCL_BS],r[MCL_BS];
+#if MCL_CURVETYPE!=MCL_MONTGOMERY
+  mcl_chunk f[MCL_BS];
+  MCL_ECP P,Q;
+#endif
+
+  for (i=0;i<32;i++) seed[i]=(char)i;
+  MCL_RAND_seed(&RNG,32,seed);
+  MCL_BIG_rcopy(r,MCL_CURVE_Order);
+
+#ifdef MCL_COMB_ORDERBITS
+  rc+=check_table();
+#endif
+
+  /* small and large multipliers, odd and even */
+  for (i=0;i<4;i++)
+  {
+    MCL_BIG_zero(e); MCL_BIG_inc(e,i); MCL_BIG_norm(e);
+    rc+=check(e);
+    MCL_BIG_copy(e,r); MCL_BIG_dec(e,i+1); MCL_BIG_norm(e);
+    rc+=check(e);
+  }
+
+  for (i=0;i<TRIALS;i++)
+  {
+    MCL_BIG_randomnum(e,r,&RNG);
+    rc+=check(e);
+  }
+
+  printf("MCL_ECP_mul_gen against MCL_ECP_mul: %s\r\n", rc ? "FAILED" : "OK");
+
+#if MCL_CURVETYPE!=MCL_MONTGOMERY
+  rc=0;
+  MCL_BIG_one(e); MCL_ECP_mul_gen(&Q,e);  /* Q=G */
+  for (i=0;i<TRIALS;i++)
+  {
+    MCL_BIG_randomnum(e,r,&RNG);
+    MCL_ECP_mul_gen(&P,e);
+    MCL_BIG_randomnum(e,r,&RNG);
+    MCL_BIG_randomnum(f,r,&RNG);
+    /* zero, one and equal multipliers */
+    if (i==0) MCL_BIG_zero(e);
+    if (i==1) MCL_BIG_zero(f);
+    if (i==2) MCL_BIG_one(e);
+    if (i==3) MCL_BIG_copy(f,e);
+    rc+=check2(&P,&Q,e,f);
+  }
+  /* P=Q */
+  rc+=check2(&Q,&Q,e,f);
+  printf("MCL_ECP_mul2_vartime against MCL_ECP_mul2: %s\r\n", rc ? "FAILED" : "OK");
+#endif
+  MCL_RAND_clean(&RNG);
+}
+
+#ifdef MCL_BUILD_ARM
+/* Thread handle */
+static os_thread_t test_thread;
+/* Buffer to be used as stack */
+static os_thread_stack_define(test_stack, 8 * 1024);
+
+/* create shadow yield thread */
+static int create_test_thread()
+{
+	int ret;
+	ret = os_thread_create(
+		/* thread handle */
+		&test_thread,
+		/* thread name */
+		"test",
+		/* entry function */
+		test,
+		/* argument */
+		0,
+		/* stack */
+		&test_stack,
+		/* priority */
+		OS_PRIO_3);
+	if (ret != WM_SUCCESS) {
+		wmprintf("Failed to create shadow yield thread: %d\r\n", ret);
+		return -WM_FAIL;
+	}
+	return WM_SUCCESS;
+}
+#endif
+
+int main(int argc, char **argv)
+{   
+#ifdef MCL_BUILD_ARM
+  /* Initialize console on uart0 */
+  wmstdio_init(UART0_ID, 0);
+#endif
+
+#ifdef MCL_BUILD_ARM
+  create_test_thread();
+#else
+#ifdef MCL_COMB_ORDERBITS
+  if (argc>1 && strcmp(argv[1],"-t")==0)
+  {
+    output_table();
+    return 0;
+  }
+#endif
+  test();
+#endif
+
+  return 0;
+}
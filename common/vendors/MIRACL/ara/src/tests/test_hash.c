@@ -45,6 +45,134 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.             *
 
 /* test program using NIST vectors */
 
+/* chunk sizes either side of the 64 and 128 byte block boundaries */
+static const int chunks[]={1,3,63,64,65,127,128,129,1000};
+
+/* hash msg fed in pieces of chunk bytes through the process_array API */
+static void hash_chunked(int sha,const char *msg,int len,int chunk,char *digest)
+{
+  int n;
+  mcl_hash256 sh256;
+  mcl_hash512 sh512;
+
+  switch (sha)
+  {
+  case MCL_SHA1: MCL_HASH160_init(&sh256); break;
+  case MCL_SHA256: MCL_HASH256_init(&sh256); break;
+  case MCL_SHA384: MCL_HASH384_init(&sh512); break;
+  case MCL_SHA512: MCL_HASH512_init(&sh512); break;
+  }
+  while (len>0)
+  {
+    n=(len<chunk) ? len : chunk;
+    switch (sha)
+    {
+    case MCL_SHA1: MCL_HASH160_process_array(&sh256,msg,n); break;
+    case MCL_SHA256: MCL_HASH256_process_array(&sh256,msg,n); break;
+    case MCL_SHA384: MCL_HASH384_process_array(&sh512,msg,n); break;
+    case MCL_SHA512: MCL_HASH512_process_array(&sh512,msg,n); break;
+    }
+    msg+=n;
+    len-=n;
+  }
+  switch (sha)
+  {
+  case MCL_SHA1: MCL_HASH160_hash(&sh256,digest); break;
+  case MCL_SHA256: MCL_HASH256_hash(&sh256,digest); break;
+  case MCL_SHA384: MCL_HASH384_hash(&sh512,digest); break;
+  case MCL_SHA512: MCL_HASH512_hash(&sh512,digest); break;
+  }
+}
+
+/* check msg against the expected digest for every chunk size */
+static int test_chunked(char *name,int sha,const char *msg,int len,char *want)
+{
+  int i,rc=0;
+  char digest[64];
+  char got[2*64+1];
+
+  for (i=0;i<(int)(sizeof(chunks)/sizeof(chunks[0]));i++)
+  {
+    hash_chunked(sha,msg,len,chunks[i],digest);
+    MCL_bin2hex(digest,got,sha);
+    if (strcmp(want,got))
+    {
+      printf("ERROR %s chunk %d\r\nWant %s\r\nGot  %s\r\n",name,chunks[i],want,got);
+      rc++;
+    }
+  }
+  printf("%s %d bytes in chunks: %s\r\n",name,len,rc ? "FAILED" : "OK");
+  return rc;
+}
+
+static int test_multi_chunk()
+{
+  int rc=0;
+  char *Msg448 = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+  char *Msg896 = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+
+  rc+=test_chunked("SHA1",MCL_SHA1,Msg448,strlen(Msg448),"84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+  rc+=test_chunked("SHA256",MCL_SHA256,Msg448,strlen(Msg448),"248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  rc+=test_chunked("SHA256",MCL_SHA256,Msg896,strlen(Msg896),"cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1");
+  rc+=test_chunked("SHA384",MCL_SHA384,"",0,"38b060a751ac96384cd9327eb1b1e36a21fdb71114be07434c0cc7bf63f6e1da274edebfe76f65fbd51ad2f14898b95b");
+  rc+=test_chunked("SHA384",MCL_SHA384,"abc",3,"cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7");
+  rc+=test_chunked("SHA512",MCL_SHA512,"",0,"cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+  rc+=test_chunked("SHA512",MCL_SHA512,"abc",3,"ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+  rc+=test_chunked("SHA384",MCL_SHA384,Msg896,strlen(Msg896),"09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712fcc7c71a557e2db966c3e9fa91746039");
+  rc+=test_chunked("SHA512",MCL_SHA512,Msg896,strlen(Msg896),"8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+
+#ifndef MCL_BUILD_ARM
+  {
+    /* one million 'a' */
+    static char MsgMillion[1000000];
+    memset(MsgMillion,'a',sizeof(MsgMillion));
+    rc+=test_chunked("SHA1",MCL_SHA1,MsgMillion,sizeof(MsgMillion),"34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+    rc+=test_chunked("SHA256",MCL_SHA256,MsgMillion,sizeof(MsgMillion),"cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    rc+=test_chunked("SHA384",MCL_SHA384,MsgMillion,sizeof(MsgMillion),"9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985");
+    rc+=test_chunked("SHA512",MCL_SHA512,MsgMillion,sizeof(MsgMillion),"e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b");
+  }
+#endif
+  return rc;
+}
+
+/* MCL_HASH256_multi must match hashing each message on its own */
+static int test_multi()
+{
+  static const int lens[]={0,1,3,55,56,63,64,65,119,120,127,128,1000,4096,100,17,200};
+  /* 1, 8, 9 and 17 messages cover partial, full and split groups of lanes */
+  static const int counts[]={1,8,9,17};
+  static char msg[4096+17];
+  const char *m[17];
+  int len[17];
+  char want[17*32],got[17*32];
+  int i,j,n,rc=0;
+  mcl_hash256 sh;
+
+  for (i=0;i<(int)sizeof(msg);i++)
+    msg[i]=(char)(i*7+1);
+
+  for (j=0;j<4;j++)
+  {
+    n=counts[j];
+    for (i=0;i<n;i++)
+    { /* odd offsets so the messages are not aligned */
+      m[i]=&msg[i];
+      len[i]=lens[i];
+      MCL_HASH256_init(&sh);
+      MCL_HASH256_process_array(&sh,m[i],len[i]);
+      MCL_HASH256_hash(&sh,&want[32*i]);
+    }
+    MCL_HASH256_multi(n,m,len,got);
+    if (memcmp(want,got,32*n))
+    {
+      printf("ERROR SHA256 multi-buffer %d messages\r\n",n);
+      rc++;
+    }
+  }
+  printf("SHA256 multi-buffer: %s\r\n",rc ? "FAILED" : "OK");
+  return rc;
+}
+
 static void test()
 {
   char digest[64];
@@ -113,6 +241,18 @@ static void test()
   for (i=0;i<64;i++) 
     printf("%02x",(unsigned char)digest[i]);
   printf("\r\n");
+
+  test_multi_chunk();
+  test_multi();
+
+  if (MCL_HASH_features())
+  { /* and again on the portable code */
+    printf("Hardware hash features %d, repeating with portable code\r\n",MCL_HASH_features());
+    MCL_HASH_set_features(0);
+    test_multi_chunk();
+    test_multi();
+    MCL_HASH_set_features(-1);
+  }
 }
 
 #ifdef MCL_BUILD_ARM
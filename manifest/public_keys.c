@@ -149,3 +149,135 @@ const crypto_public_key public_keys[] = {
 };
 
 const uint32_t number_of_public_keys = sizeof(public_keys)/sizeof(crypto_public_key);
+
+const crypto_key_ext public_keys_ext = {
+    .sentinel = CRYPTO_KEY_EXT_SENTINEL,
+    .version = CRYPTO_KEY_EXT_VERSION,
+    .number_of_keys = 4,
+    .mont = {
+        {
+            .n0inv = 0xf72e27dd,
+            .r2 = {
+                0x37, 0x12, 0xf7, 0xa3, 0xb9, 0x1b, 0xee, 0x96, 0x41, 0xa3, 0x51, 0x24,
+                0xbe, 0x3a, 0xb8, 0x14, 0x89, 0xd5, 0xec, 0xe5, 0x02, 0x2b, 0x99, 0x41,
+                0x8a, 0x0b, 0x53, 0x48, 0xec, 0x81, 0x21, 0xbf, 0xf0, 0x6b, 0x55, 0x8d,
+                0x29, 0x93, 0x0e, 0xb8, 0xf7, 0xc3, 0x87, 0xf2, 0x94, 0xda, 0x37, 0xaf,
+                0xc7, 0x28, 0x40, 0x47, 0xc0, 0x56, 0x4e, 0x02, 0x34, 0xc2, 0x3d, 0x2d,
+                0x5b, 0x28, 0x0a, 0x6d, 0x8c, 0xd8, 0x4f, 0x7d, 0xed, 0xec, 0x49, 0x9f,
+                0xbb, 0xcf, 0xde, 0xcc, 0xb8, 0x95, 0xfe, 0xd8, 0xa7, 0x0e, 0x94, 0x34,
+                0x6b, 0x61, 0x1f, 0xef, 0xf0, 0x2a, 0x19, 0x13, 0xc6, 0x6b, 0x17, 0x6d,
+                0x67, 0x13, 0xa3, 0x29, 0xea, 0x08, 0x9e, 0x11, 0x95, 0x2d, 0x70, 0xd8,
+                0xba, 0x3d, 0x33, 0x11, 0x69, 0x5e, 0x2e, 0x72, 0xda, 0x68, 0x87, 0xc1,
+                0x82, 0x3c, 0x0e, 0xcc, 0x4e, 0x32, 0x20, 0x73, 0x83, 0xa2, 0x92, 0x8e,
+                0xb4, 0xc9, 0xdb, 0x5f, 0xaf, 0x1f, 0xc4, 0x10, 0x0b, 0x59, 0x6c, 0x9d,
+                0x22, 0x11, 0x71, 0x96, 0x52, 0xbb, 0x4a, 0x6f, 0x1a, 0x1f, 0x00, 0x4a,
+                0xbf, 0x3e, 0x37, 0xf1, 0x77, 0x66, 0x29, 0xf0, 0xe9, 0x37, 0x57, 0x64,
+                0x7b, 0x7c, 0xc9, 0xdb, 0xec, 0x62, 0x3f, 0xbf, 0x94, 0x5d, 0x66, 0xaf,
+                0x0e, 0x35, 0x23, 0x40, 0x5c, 0xa3, 0xe6, 0x9b, 0xdc, 0x17, 0x9a, 0x89,
+                0xe4, 0xa7, 0xa8, 0xed, 0x59, 0xab, 0x2f, 0xd8, 0x1a, 0xc9, 0x07, 0x7e,
+                0x2a, 0x9e, 0xc8, 0x11, 0x9d, 0xd7, 0xb1, 0x13, 0x67, 0x07, 0xc8, 0x15,
+                0x8f, 0xa3, 0xec, 0x62, 0x22, 0xa7, 0x95, 0x9f, 0x68, 0x55, 0x6f, 0x3a,
+                0xc0, 0x66, 0x46, 0x80, 0xb7, 0x45, 0x17, 0x63, 0x80, 0xf2, 0x08, 0xc4,
+                0x92, 0xc1, 0xd7, 0x48, 0x9e, 0xb4, 0xdc, 0x5c, 0xe9, 0x70, 0xcb, 0x6d,
+                0x28, 0x77, 0xbc, 0x5f
+            }
+        },
+        {
+            .n0inv = 0x17d90cab,
+            .r2 = {
+                0x08, 0x80, 0x12, 0x59, 0x22, 0x82, 0x64, 0xc3, 0x4a, 0xac, 0xcb, 0x4a,
+                0x08, 0x6d, 0xde, 0x49, 0xc9, 0x55, 0x7f, 0x71, 0xc7, 0xf1, 0x4c, 0x27,
+                0xc8, 0x1a, 0x80, 0x32, 0x01, 0xb0, 0xb6, 0x6b, 0xed, 0x09, 0x40, 0x0d,
+                0xd4, 0xa6, 0xc0, 0x6f, 0x60, 0xd3, 0x38, 0xcf, 0x53, 0x4e, 0xad, 0xb5,
+                0x74, 0xb8, 0x8c, 0xb3, 0x70, 0x37, 0x9a, 0x28, 0x48, 0xd5, 0x35, 0xf2,
+                0xed, 0x64, 0x27, 0xeb, 0x01, 0x55, 0xc8, 0x9b, 0xfe, 0xa5, 0xfb, 0xc9,
+                0xc3, 0x1e, 0x47, 0xed, 0x0d, 0x03, 0x2b, 0x57, 0x1c, 0x35, 0x09, 0x96,
+                0xd2, 0xc8, 0xb4, 0x2b, 0x06, 0x4e, 0x57, 0x0f, 0x26, 0x3a, 0x99, 0x04,
+                0xd4, 0x73, 0x05, 0xca, 0x19, 0x00, 0xf7, 0xae, 0x1d, 0x92, 0xeb, 0x6d,
+                0xd8, 0xea, 0x98, 0xfe, 0xa0, 0x49, 0xa2, 0x11, 0xf9, 0xd4, 0x01, 0xa1,
+                0x5b, 0x34, 0x9a, 0x4f, 0x91, 0x14, 0xb6, 0x26, 0x98, 0x08, 0xb9, 0x66,
+                0x4f, 0xc7, 0xf4, 0x0f, 0x53, 0x1b, 0x1d, 0x74, 0xa3, 0xc9, 0x98, 0xd0,
+                0xc6, 0xf9, 0x5e, 0xd3, 0xd3, 0x8c, 0x8d, 0xc2, 0x25, 0xfd, 0x65, 0x04,
+                0x54, 0x41, 0xb3, 0xac, 0x9d, 0x4e, 0xb5, 0x94, 0xc5, 0x47, 0x47, 0x11,
+                0x83, 0x1e, 0xf9, 0xd6, 0x97, 0x21, 0xc6, 0xae, 0xa1, 0xdc, 0xd8, 0xa2,
+                0xa8, 0xa2, 0xae, 0x9e, 0x8d, 0x7b, 0xf9, 0x8a, 0xcf, 0xa5, 0x5f, 0x1f,
+                0xa3, 0xb1, 0x5c, 0x1b, 0xcb, 0x91, 0x6c, 0x81, 0xdd, 0xef, 0x2c, 0xbc,
+                0x4e, 0x7b, 0xdc, 0xb2, 0x3d, 0x58, 0xd6, 0x68, 0xec, 0x24, 0xbe, 0x99,
+                0xaa, 0xa8, 0x2e, 0x73, 0x50, 0x8c, 0x8b, 0x94, 0xe6, 0xde, 0x3b, 0xe6,
+                0x0d, 0x28, 0xae, 0x1c, 0x9f, 0x27, 0x41, 0x8f, 0x82, 0xda, 0x81, 0x03,
+                0x09, 0xbd, 0x71, 0x38, 0x12, 0x30, 0xc6, 0x59, 0xc5, 0x10, 0x35, 0x31,
+                0x75, 0x25, 0x9d, 0xe6
+            }
+        },
+        {
+            .n0inv = 0xadabf809,
+            .r2 = {
+                0x31, 0x20, 0x27, 0xfb, 0x77, 0x27, 0x95, 0xea, 0x36, 0xd1, 0xdd, 0x43,
+                0x69, 0x0f, 0x35, 0x3d, 0x94, 0x69, 0x15, 0x2c, 0xa5, 0x5d, 0x9e, 0x97,
+                0x24, 0x03, 0x40, 0x61, 0x45, 0x34, 0xdf, 0xd9, 0x8c, 0xb8, 0x12, 0x58,
+                0x06, 0x31, 0x3c, 0x7c, 0x35, 0x21, 0xf7, 0x24, 0x57, 0xb0, 0xf6, 0xe3,
+                0x65, 0x58, 0xe3, 0x9c, 0x72, 0x32, 0xa3, 0xd3, 0x98, 0x0f, 0x4f, 0xe4,
+                0x87, 0xd7, 0x2f, 0xbe, 0x30, 0xe3, 0xa2, 0xab, 0x2c, 0x89, 0x75, 0x23,
+                0xd3, 0x13, 0xa2, 0x9c, 0x55, 0xad, 0x31, 0xa1, 0x0f, 0x5b, 0xc6, 0x88,
+                0xcb, 0xf2, 0xff, 0x13, 0xb0, 0xa8, 0xda, 0xc8, 0x4d, 0x0d, 0x00, 0xcf,
+                0x23, 0x8f, 0xc9, 0x56, 0xfc, 0xc2, 0xba, 0x77, 0x91, 0xde, 0x39, 0x6e,
+                0x4f, 0x7f, 0x8d, 0xaf, 0x83, 0xac, 0x55, 0xcb, 0x0f, 0xbd, 0x34, 0xd7,
+                0x1e, 0xdd, 0x89, 0x7f, 0x81, 0xc1, 0xc7, 0x03, 0x46, 0xb5, 0x6a, 0xbc,
+                0x2d, 0x30, 0x66, 0x41, 0xd0, 0xf8, 0xf1, 0x3c, 0x25, 0x21, 0x6e, 0x01,
+                0x65, 0xf0, 0x34, 0x92, 0x3d, 0x4c, 0x2a, 0x2d, 0xc4, 0x16, 0x91, 0x5d,
+                0xd2, 0x36, 0x0e, 0xfd, 0x00, 0x97, 0x25, 0xef, 0xeb, 0xa3, 0x8c, 0x7f,
+                0x42, 0x33, 0xe6, 0x4a, 0x4c, 0x07, 0x11, 0xbb, 0xca, 0x7d, 0x64, 0xd4,
+                0x20, 0x87, 0x25, 0x53, 0xc4, 0x91, 0x2f, 0x52, 0xd3, 0x5a, 0x39, 0x90,
+                0x96, 0x25, 0xe1, 0x99, 0xe4, 0x9b, 0x46, 0xfa, 0x6f, 0xd3, 0x0c, 0xa0,
+                0x91, 0x81, 0x97, 0x47, 0x76, 0xb2, 0x08, 0x16, 0xb9, 0x9b, 0xf6, 0x6f,
+                0xe2, 0xb9, 0xb0, 0xd5, 0xb6, 0xd4, 0xa6, 0x13, 0x48, 0x4b, 0x2a, 0xdb,
+                0xf7, 0xe3, 0x1b, 0x63, 0x50, 0xf5, 0x27, 0x1a, 0x57, 0xb1, 0xae, 0x1a,
+                0x08, 0xa3, 0x62, 0x43, 0x44, 0x6c, 0x27, 0xcd, 0x1d, 0xa9, 0x08, 0x2c,
+                0x7c, 0xbd, 0x8f, 0x97
+            }
+        },
+        {
+            .n0inv = 0x08ba51d3,
+            .r2 = {
+                0x9e, 0x71, 0x75, 0x35, 0x5b, 0x4a, 0xd5, 0xc0, 0x95, 0x53, 0x4d, 0x62,
+                0xd1, 0x01, 0x55, 0x24, 0x41, 0xfe, 0xc7, 0xac, 0x16, 0xeb, 0xaf, 0x6a,
+                0x53, 0x83, 0xa9, 0xc6, 0x25, 0x27, 0x61, 0x79, 0x1e, 0xe1, 0xc6, 0xfe,
+                0x8c, 0x16, 0xac, 0x0e, 0xa4, 0x5f, 0xed, 0x25, 0x0c, 0x60, 0xfc, 0x6d,
+                0x23, 0x42, 0x85, 0x1c, 0xed, 0x62, 0x26, 0xcf, 0x8c, 0x1b, 0x29, 0x6a,
+                0x40, 0x2e, 0x79, 0x2c, 0x36, 0xb3, 0xda, 0x1d, 0x30, 0x43, 0x3f, 0xfa,
+                0x53, 0x3f, 0xad, 0xbd, 0xfc, 0x5b, 0xfd, 0x34, 0x7b, 0xe6, 0x46, 0x4b,
+                0x52, 0x3e, 0x01, 0xf6, 0xb5, 0xef, 0x2c, 0x38, 0x51, 0xfc, 0x02, 0xf6,
+                0xf6, 0xc5, 0x91, 0x72, 0xdd, 0x7e, 0x0e, 0x2c, 0x0f, 0x89, 0x37, 0x16,
+                0x22, 0x6f, 0x41, 0x7f, 0x83, 0xbc, 0xf4, 0x46, 0xf7, 0xc9, 0x26, 0xbd,
+                0x75, 0xcf, 0xbf, 0xf6, 0x08, 0x77, 0x61, 0xd0, 0xf0, 0x88, 0x6c, 0x2f,
+                0x29, 0x3a, 0x7e, 0xa5, 0xba, 0xe7, 0x8e, 0x0e, 0x13, 0x48, 0xef, 0x31,
+                0x6a, 0x83, 0x85, 0x0f, 0xa2, 0x1f, 0xd9, 0x8b, 0xb3, 0x28, 0xaa, 0x4e,
+                0x13, 0xb0, 0xe5, 0x4b, 0x72, 0x6b, 0x96, 0xfa, 0x3e, 0x8c, 0x5f, 0xa7,
+                0x52, 0x22, 0xc4, 0x04, 0xa2, 0x02, 0x0f, 0xf5, 0x1d, 0x3e, 0xd4, 0x07,
+                0xa3, 0x12, 0xb8, 0x30, 0x19, 0x4a, 0x1b, 0xc5, 0xa6, 0xb6, 0x65, 0xfa,
+                0x89, 0x1b, 0x2d, 0x16, 0x53, 0x0a, 0x77, 0xcd, 0x04, 0xa1, 0x73, 0x1c,
+                0x69, 0xa4, 0x7b, 0x72, 0x10, 0x16, 0xeb, 0x35, 0xa7, 0x8b, 0xc3, 0x37,
+                0xab, 0x1b, 0x4a, 0x14, 0x25, 0x9f, 0x20, 0xb2, 0xbf, 0x51, 0xee, 0xd4,
+                0xda, 0x07, 0x43, 0x06, 0xf8, 0x5a, 0x3c, 0x69, 0xf6, 0x20, 0x3c, 0x00,
+                0x7c, 0x0b, 0x49, 0xae, 0x3c, 0x68, 0x6f, 0x58, 0xb7, 0x51, 0x34, 0x01,
+                0xf8, 0x86, 0x64, 0x8d
+            }
+        },
+    }
+};
+
+const crypto_key_index public_keys_index = {
+    .sentinel = CRYPTO_KEY_INDEX_SENTINEL,
+    .number_of_keys = 4,
+    .number_of_slots = 8,
+    .slots = {
+        { 0x69573540, 2 },
+        { 0xead09819, 3 },
+        { 0x1dccf06a, 4 },
+        { 0x00000000, 0 },
+        { 0x00000000, 0 },
+        { 0x00000000, 0 },
+        { 0x00000000, 0 },
+        { 0x77682ad7, 1 },
+    }
+};
@@ -97,6 +97,21 @@ XAFLAGS += -D_SPECIAL_TEST=$(_SPECIAL_TEST)
 endif
 endif
 
+#  _SPI_STATS==1:  Count SPI polls, hashed chunks, READs, overruns and load cycles
+#  _SPI_STATS!=1:  No SPI load statistics
+ifeq ($(_SPI_STATS),1)
+XCFLAGS += -D_SPI_STATS
+XAFLAGS += -D_SPI_STATS
+endif
+
+#  _HOST_HASH_BACKEND==1:  Hash through a software stand-in for a hash engine,
+#                          checking that every hashed byte went through it
+#  _HOST_HASH_BACKEND!=1:  Use the chip's hash engine, if any
+ifeq ($(_HOST_HASH_BACKEND),1)
+XCFLAGS += -D_HOST_HASH_BACKEND
+XAFLAGS += -D_HOST_HASH_BACKEND
+endif
+
 #  _CLEAR_MIN_MEMORY==1:  Clear only the minimum of RAM at startup
 #  _CLEAR_MIN_MEMORY!=1:  Clear all of RAM at startup
 ifeq ($(_CLEAR_MIN_MEMORY),1)